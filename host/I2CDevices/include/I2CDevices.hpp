@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+/**
+ * @class I2CDevices
+ * @brief Version hôte de l'interface I2CDevices utilisée par le composant BQ2579X.
+ *
+ * Seules les deux opérations dont dépend INTERFACE sont exposées ; une
+ * implémentation concrète (BQ25798Sim) fournit le composant simulé.
+ */
+class I2CDevices
+{
+public:
+    virtual ~I2CDevices() = default;
+
+    virtual esp_err_t read(uint8_t reg, uint8_t *data, size_t len) = 0;
+    virtual esp_err_t write(uint8_t reg, const uint8_t *data, size_t len) = 0;
+};
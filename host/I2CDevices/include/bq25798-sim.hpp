@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include "I2CDevices.hpp"
+
+namespace bq2579x
+{
+    /**
+     * @class BQ25798Sim
+     * @brief Modèle hôte du BQ25798 derrière l'interface I2CDevices.
+     *
+     * Reproduit ce dont dépend le driver : auto-incrément en lecture et en écriture,
+     * registres en lecture seule, flags REG22h..REG27h effacés à la lecture,
+     * Part Information en REG48h, conversions ADC (REG2Eh) à durée dépendante de
+     * la résolution, watchdog I2C (REG10h) qui recharge les registres de
+     * configuration, latence et injection d'erreurs configurables.
+     *
+     * Le temps est virtuel par défaut (advance_us()) pour des mesures
+     * reproductibles ; set_wall_clock(true) suit l'horloge réelle.
+     */
+    class BQ25798Sim : public I2CDevices
+    {
+    public:
+        static constexpr size_t REG_COUNT = 0x49; // REG00h..REG48h
+
+        struct Latency
+        {
+            uint32_t per_transaction_us = 0; // start + adresse + registre + stop
+            uint32_t per_byte_us = 0;        // ~90 us/octet à 100 kHz
+            bool real_sleep = false;         // dort réellement en plus d'avancer l'horloge virtuelle
+        };
+
+        struct ErrorInjection
+        {
+            uint32_t fail_next = 0;       // les N prochaines transactions échouent
+            uint32_t fail_every = 0;      // une transaction sur N échoue (0 = jamais)
+            int16_t only_reg = -1;        // limite l'injection aux transactions démarrant à ce registre
+            esp_err_t error = ESP_FAIL;   // code retourné
+        };
+
+        struct Counters
+        {
+            uint32_t reads = 0;
+            uint32_t writes = 0;
+            uint32_t bytes_read = 0;
+            uint32_t bytes_written = 0;
+            uint32_t injected_errors = 0;
+            uint32_t watchdog_expirations = 0;
+            uint32_t adc_conversions = 0;
+            uint32_t interrupts = 0;
+        };
+
+        using InterruptHandler = void (*)(void *ctx);
+
+        BQ25798Sim();
+
+        esp_err_t read(uint8_t reg, uint8_t *data, size_t len) override;
+        esp_err_t write(uint8_t reg, const uint8_t *data, size_t len) override;
+
+        /// Recharge toutes les valeurs par défaut (mise sous tension)
+        void power_on_reset();
+
+        void set_wall_clock(bool enable);
+        void advance_us(uint64_t us);
+        uint64_t now_us();
+
+        /// Met à jour un registre de statut et lève les flags correspondant aux bits modifiés
+        void set_status(uint8_t reg, uint8_t value);
+
+        /// Lève directement des bits dans un registre de flags (REG22h..REG27h)
+        void raise_flags(uint8_t reg, uint8_t bits);
+
+        /// Valeur analogique présentée à un canal ADC, recopiée à la fin de la conversion suivante
+        void set_adc_input(uint8_t reg, uint16_t raw);
+
+        uint8_t peek(uint8_t reg);
+        void poke(uint8_t reg, uint8_t value);
+
+        void set_latency(const Latency &latency);
+        void set_error_injection(const ErrorInjection &injection);
+
+        /// Impulsion INT simulée (flag levé non masqué)
+        void set_interrupt_handler(InterruptHandler handler, void *ctx);
+
+        Counters counters();
+        void reset_counters();
+
+    private:
+        std::mutex lock_;
+
+        uint8_t regs_[REG_COUNT] = {};
+        uint16_t adc_inputs_[REG_COUNT] = {};
+
+        bool wall_clock_ = false;
+        uint64_t virtual_us_ = 0;
+        uint64_t wall_origin_us_ = 0;
+
+        uint64_t watchdog_start_us_ = 0;
+        bool adc_running_ = false;
+        uint64_t adc_done_us_ = 0;
+
+        Latency latency_ = {};
+        ErrorInjection injection_ = {};
+        uint32_t transaction_index_ = 0;
+        Counters counters_ = {};
+
+        InterruptHandler int_handler_ = nullptr;
+        void *int_ctx_ = nullptr;
+        bool int_pending_ = false;
+
+        uint64_t clock_us() const;
+        void update();
+        void load_defaults(uint8_t first, uint8_t last);
+        void restart_watchdog();
+        uint64_t watchdog_timeout_us() const;
+        void start_adc();
+        uint64_t adc_conversion_us() const;
+        void finish_adc();
+        void flag(uint8_t reg, uint8_t bits);
+        bool inject_error(uint8_t reg);
+        void apply_latency(size_t len);
+        void fire_pending_interrupt();
+
+        static bool is_writable(uint8_t reg);
+        static bool is_flag(uint8_t reg);
+    };
+
+} // namespace bq2579x
@@ -0,0 +1,471 @@
+#include "bq25798-sim.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace bq2579x
+{
+    namespace
+    {
+        // Valeurs par défaut à la mise sous tension (configuration 2S de la datasheet)
+        constexpr uint8_t POR_DEFAULTS[BQ25798Sim::REG_COUNT] = {
+            /* 0x00 */ 0x12, 0x03, 0x48, 0x00, 0x64, 0x24, 0x01, 0x2C,
+            /* 0x08 */ 0xC3, 0x05, 0x7A, 0x00, 0xDC, 0x4C, 0x3D, 0xA2,
+            /* 0x10 */ 0x85, 0x40, 0x00, 0x00, 0x16, 0xAA, 0xC0, 0x7A,
+            /* 0x18 */ 0x54, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            /* 0x20 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            /* 0x28 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00,
+            /* 0x30 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            /* 0x38 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            /* 0x40 */ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            /* 0x48 */ 0x19, // PN = 011 (BQ25798), DEV_REV = 001
+        };
+
+        constexpr uint8_t REG_TERMINATION = 0x09;
+        constexpr uint8_t REG_CHARGER_CONTROL1 = 0x10;
+        constexpr uint8_t REG_CHARGER_STATUS0 = 0x1B;
+        constexpr uint8_t REG_CHARGER_STATUS1 = 0x1C;
+        constexpr uint8_t REG_CHARGER_STATUS2 = 0x1D;
+        constexpr uint8_t REG_CHARGER_STATUS3 = 0x1E;
+        constexpr uint8_t REG_CHARGER_STATUS4 = 0x1F;
+        constexpr uint8_t REG_FAULT_STATUS0 = 0x20;
+        constexpr uint8_t REG_FAULT_STATUS1 = 0x21;
+        constexpr uint8_t REG_CHARGER_FLAG0 = 0x22;
+        constexpr uint8_t REG_CHARGER_FLAG1 = 0x23;
+        constexpr uint8_t REG_CHARGER_FLAG2 = 0x24;
+        constexpr uint8_t REG_CHARGER_FLAG3 = 0x25;
+        constexpr uint8_t REG_FAULT_FLAG0 = 0x26;
+        constexpr uint8_t REG_FAULT_FLAG1 = 0x27;
+        constexpr uint8_t REG_CHARGER_MASK0 = 0x28;
+        constexpr uint8_t REG_ADC_CONTROL = 0x2E;
+        constexpr uint8_t REG_ADC_DISABLE0 = 0x2F;
+        constexpr uint8_t REG_ADC_DISABLE1 = 0x30;
+        constexpr uint8_t REG_ADC_FIRST = 0x31;
+        constexpr uint8_t REG_ADC_LAST = 0x46;
+
+        constexpr uint8_t REG_RST = 1 << 6;   // REG09h
+        constexpr uint8_t WD_RST = 1 << 3;    // REG10h
+        constexpr uint8_t WD_STAT = 1 << 5;   // REG1Bh / REG22h
+        constexpr uint8_t ADC_EN = 1 << 7;    // REG2Eh
+        constexpr uint8_t ADC_RATE = 1 << 6;  // REG2Eh, 1 = one-shot
+        constexpr uint8_t ADC_DONE = 1 << 5;  // REG1Eh / REG24h
+
+        // Canaux ADC : registre résultat et bit de désactivation (REG2Fh puis REG30h)
+        struct AdcChannel
+        {
+            uint8_t reg;
+            uint8_t disable_reg;
+            uint8_t disable_bit;
+        };
+
+        constexpr AdcChannel ADC_CHANNELS[] = {
+            {0x31, REG_ADC_DISABLE0, 7}, // IBUS
+            {0x33, REG_ADC_DISABLE0, 6}, // IBAT
+            {0x35, REG_ADC_DISABLE0, 5}, // VBUS
+            {0x37, REG_ADC_DISABLE1, 4}, // VAC1
+            {0x39, REG_ADC_DISABLE1, 5}, // VAC2
+            {0x3B, REG_ADC_DISABLE0, 4}, // VBAT
+            {0x3D, REG_ADC_DISABLE0, 3}, // VSYS
+            {0x3F, REG_ADC_DISABLE0, 2}, // TS
+            {0x41, REG_ADC_DISABLE0, 1}, // TDIE
+            {0x43, REG_ADC_DISABLE1, 7}, // D+
+            {0x45, REG_ADC_DISABLE1, 6}, // D-
+        };
+
+        uint64_t steady_us()
+        {
+            using namespace std::chrono;
+            return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    BQ25798Sim::BQ25798Sim()
+    {
+        power_on_reset();
+    }
+
+    void BQ25798Sim::power_on_reset()
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        load_defaults(0x00, REG_COUNT - 1);
+        for (auto &input : adc_inputs_)
+            input = 0;
+        adc_running_ = false;
+        restart_watchdog();
+    }
+
+    // === Accès I2C ===
+
+    esp_err_t BQ25798Sim::read(uint8_t reg, uint8_t *data, size_t len)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            update();
+            apply_latency(len);
+
+            if (inject_error(reg))
+                return injection_.error;
+            if (len == 0 || reg + len > REG_COUNT)
+                return ESP_ERR_INVALID_ARG;
+
+            for (size_t i = 0; i < len; ++i)
+            {
+                const uint8_t addr = reg + i;
+                data[i] = regs_[addr];
+                if (is_flag(addr))
+                    regs_[addr] = 0; // effacement à la lecture
+            }
+            counters_.reads++;
+            counters_.bytes_read += len;
+        }
+        fire_pending_interrupt();
+        return ESP_OK;
+    }
+
+    esp_err_t BQ25798Sim::write(uint8_t reg, const uint8_t *data, size_t len)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            update();
+            apply_latency(len);
+
+            if (inject_error(reg))
+                return injection_.error;
+            if (len == 0 || reg + len > REG_COUNT)
+                return ESP_ERR_INVALID_ARG;
+
+            for (size_t i = 0; i < len; ++i)
+            {
+                const uint8_t addr = reg + i;
+                if (!is_writable(addr))
+                    continue;
+                regs_[addr] = data[i];
+
+                if (addr == REG_TERMINATION && (data[i] & REG_RST))
+                {
+                    load_defaults(0x00, REG_COUNT - 1);
+                    restart_watchdog();
+                }
+                else if (addr == REG_CHARGER_CONTROL1)
+                {
+                    // WD_RST et tout changement de timeout relancent le watchdog ; le bit revient à 0
+                    regs_[addr] &= ~WD_RST;
+                    restart_watchdog();
+                }
+                else if (addr == REG_ADC_CONTROL && (data[i] & ADC_EN))
+                {
+                    start_adc();
+                }
+            }
+            counters_.writes++;
+            counters_.bytes_written += len;
+        }
+        fire_pending_interrupt();
+        return ESP_OK;
+    }
+
+    // === Pilotage du modèle ===
+
+    void BQ25798Sim::set_wall_clock(bool enable)
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (enable && !wall_clock_)
+            wall_origin_us_ = steady_us() - virtual_us_;
+        else if (!enable && wall_clock_)
+            virtual_us_ = steady_us() - wall_origin_us_;
+        wall_clock_ = enable;
+    }
+
+    void BQ25798Sim::advance_us(uint64_t us)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            virtual_us_ += us;
+            update();
+        }
+        fire_pending_interrupt();
+    }
+
+    uint64_t BQ25798Sim::now_us()
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        return clock_us();
+    }
+
+    void BQ25798Sim::set_status(uint8_t reg, uint8_t value)
+    {
+        if (reg < REG_CHARGER_STATUS0 || reg > REG_FAULT_STATUS1)
+            return;
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            const uint8_t changed = regs_[reg] ^ value;
+            regs_[reg] = value;
+
+            switch (reg)
+            {
+            case REG_CHARGER_STATUS1:
+                // CHG_STAT[7:5] -> CHG_FLAG, VBUS_STAT[4:1] -> VBUS_FLAG, BC1.2_DONE -> BC1.2_DONE_FLAG
+                flag(REG_CHARGER_FLAG1, ((changed & 0xE0) ? 0x80 : 0) | ((changed & 0x1E) ? 0x10 : 0) | (changed & 0x01));
+                break;
+            case REG_CHARGER_STATUS2:
+                // ICO_STAT[7:6] -> ICO_FLAG, TREG_STAT -> TREG_FLAG, VBAT_PRESENT_STAT -> VBAT_PRESENT_FLAG
+                flag(REG_CHARGER_FLAG1, ((changed & 0xC0) ? 0x40 : 0) | (changed & 0x04) | ((changed & 0x01) << 1));
+                // DPDM_STAT retombé : détection D+/D- terminée -> DPDM_DONE_FLAG
+                if ((changed & 0x02) && !(value & 0x02))
+                    flag(REG_CHARGER_FLAG2, 0x40);
+                break;
+            case REG_CHARGER_STATUS0:
+                flag(REG_CHARGER_FLAG0, changed);
+                break;
+            case REG_CHARGER_STATUS3:
+                // ADC_DONE, VSYS, CHG_TMR, TRICHG_TMR, PRECHG_TMR ; ACRB2/ACRB1_STAT n'ont pas de flag
+                flag(REG_CHARGER_FLAG2, changed & 0x3E);
+                break;
+            case REG_CHARGER_STATUS4:
+                // VBATOTG_LOW, TS_COLD/COOL/WARM/HOT
+                flag(REG_CHARGER_FLAG3, changed & 0x1F);
+                break;
+            case REG_FAULT_STATUS0:
+                flag(REG_FAULT_FLAG0, changed);
+                break;
+            case REG_FAULT_STATUS1:
+                // VSYS_SHORT, VSYS_OVP, OTG_OVP, OTG_UVP, TSHUT
+                flag(REG_FAULT_FLAG1, changed & 0xF4);
+                break;
+            }
+        }
+        fire_pending_interrupt();
+    }
+
+    void BQ25798Sim::raise_flags(uint8_t reg, uint8_t bits)
+    {
+        if (!is_flag(reg))
+            return;
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            flag(reg, bits);
+        }
+        fire_pending_interrupt();
+    }
+
+    void BQ25798Sim::set_adc_input(uint8_t reg, uint16_t raw)
+    {
+        if (reg < REG_ADC_FIRST || reg >= REG_ADC_LAST)
+            return;
+        std::lock_guard<std::mutex> guard(lock_);
+        adc_inputs_[reg] = raw;
+    }
+
+    uint8_t BQ25798Sim::peek(uint8_t reg)
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        return reg < REG_COUNT ? regs_[reg] : 0;
+    }
+
+    void BQ25798Sim::poke(uint8_t reg, uint8_t value)
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (reg < REG_COUNT)
+            regs_[reg] = value;
+    }
+
+    void BQ25798Sim::set_latency(const Latency &latency)
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        latency_ = latency;
+    }
+
+    void BQ25798Sim::set_error_injection(const ErrorInjection &injection)
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        injection_ = injection;
+        transaction_index_ = 0;
+    }
+
+    void BQ25798Sim::set_interrupt_handler(InterruptHandler handler, void *ctx)
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        int_handler_ = handler;
+        int_ctx_ = ctx;
+    }
+
+    BQ25798Sim::Counters BQ25798Sim::counters()
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        return counters_;
+    }
+
+    void BQ25798Sim::reset_counters()
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        counters_ = {};
+    }
+
+    // === Modèle interne (appelé sous lock_) ===
+
+    uint64_t BQ25798Sim::clock_us() const
+    {
+        return wall_clock_ ? steady_us() - wall_origin_us_ : virtual_us_;
+    }
+
+    void BQ25798Sim::update()
+    {
+        const uint64_t now = clock_us();
+
+        if (adc_running_ && now >= adc_done_us_)
+            finish_adc();
+
+        const uint64_t timeout = watchdog_timeout_us();
+        if (timeout != 0 && now - watchdog_start_us_ >= timeout)
+        {
+            // Expiration : registres de configuration rechargés, WD_STAT/WD_FLAG levés
+            const uint8_t watchdog = regs_[REG_CHARGER_CONTROL1] & 0x07;
+            load_defaults(0x00, 0x18);
+            regs_[REG_CHARGER_CONTROL1] = (regs_[REG_CHARGER_CONTROL1] & ~0x07) | watchdog;
+            regs_[REG_CHARGER_STATUS0] |= WD_STAT;
+            flag(REG_CHARGER_FLAG0, WD_STAT);
+            counters_.watchdog_expirations++;
+            restart_watchdog();
+        }
+    }
+
+    void BQ25798Sim::load_defaults(uint8_t first, uint8_t last)
+    {
+        for (size_t reg = first; reg <= last; ++reg)
+            regs_[reg] = POR_DEFAULTS[reg];
+    }
+
+    void BQ25798Sim::restart_watchdog()
+    {
+        watchdog_start_us_ = clock_us();
+        regs_[REG_CHARGER_STATUS0] &= ~WD_STAT;
+    }
+
+    uint64_t BQ25798Sim::watchdog_timeout_us() const
+    {
+        static constexpr uint32_t TIMEOUT_MS[8] = {0, 500, 1000, 2000, 20000, 40000, 80000, 160000};
+        return static_cast<uint64_t>(TIMEOUT_MS[regs_[REG_CHARGER_CONTROL1] & 0x07]) * 1000;
+    }
+
+    void BQ25798Sim::start_adc()
+    {
+        regs_[REG_CHARGER_STATUS3] &= ~ADC_DONE;
+        adc_running_ = true;
+        adc_done_us_ = clock_us() + adc_conversion_us();
+    }
+
+    uint64_t BQ25798Sim::adc_conversion_us() const
+    {
+        // Temps de conversion par canal selon ADC_SAMPLE[5:4] : 15, 14, 13, 12 bits
+        static constexpr uint32_t PER_CHANNEL_US[4] = {24000, 12000, 6000, 3000};
+        const uint8_t resolution = (regs_[REG_ADC_CONTROL] >> 4) & 0x03;
+
+        uint32_t enabled = 0;
+        for (const auto &channel : ADC_CHANNELS)
+        {
+            if (!(regs_[channel.disable_reg] & (1 << channel.disable_bit)))
+                enabled++;
+        }
+        return static_cast<uint64_t>(PER_CHANNEL_US[resolution]) * enabled;
+    }
+
+    void BQ25798Sim::finish_adc()
+    {
+        for (const auto &channel : ADC_CHANNELS)
+        {
+            if (regs_[channel.disable_reg] & (1 << channel.disable_bit))
+                continue;
+            regs_[channel.reg] = adc_inputs_[channel.reg] >> 8;
+            regs_[channel.reg + 1] = adc_inputs_[channel.reg] & 0xFF;
+        }
+        counters_.adc_conversions++;
+        regs_[REG_CHARGER_STATUS3] |= ADC_DONE;
+        flag(REG_CHARGER_FLAG2, ADC_DONE);
+
+        if (regs_[REG_ADC_CONTROL] & ADC_RATE)
+        {
+            // One-shot : ADC_EN revient à 0 à la fin de la conversion
+            regs_[REG_ADC_CONTROL] &= ~ADC_EN;
+            adc_running_ = false;
+        }
+        else if (regs_[REG_ADC_CONTROL] & ADC_EN)
+        {
+            adc_done_us_ += adc_conversion_us();
+        }
+        else
+        {
+            adc_running_ = false;
+        }
+    }
+
+    void BQ25798Sim::flag(uint8_t reg, uint8_t bits)
+    {
+        if (bits == 0)
+            return;
+        regs_[reg] |= bits;
+        const uint8_t mask = regs_[REG_CHARGER_MASK0 + (reg - REG_CHARGER_FLAG0)];
+        if (bits & ~mask)
+            int_pending_ = true;
+    }
+
+    bool BQ25798Sim::inject_error(uint8_t reg)
+    {
+        if (injection_.only_reg >= 0 && injection_.only_reg != reg)
+            return false;
+
+        transaction_index_++;
+        bool fail = false;
+        if (injection_.fail_next > 0)
+        {
+            injection_.fail_next--;
+            fail = true;
+        }
+        else if (injection_.fail_every != 0 && transaction_index_ % injection_.fail_every == 0)
+        {
+            fail = true;
+        }
+
+        if (fail)
+            counters_.injected_errors++;
+        return fail;
+    }
+
+    void BQ25798Sim::apply_latency(size_t len)
+    {
+        const uint64_t cost = latency_.per_transaction_us + static_cast<uint64_t>(latency_.per_byte_us) * len;
+        if (cost == 0)
+            return;
+        if (!wall_clock_)
+            virtual_us_ += cost;
+        if (latency_.real_sleep || wall_clock_)
+            std::this_thread::sleep_for(std::chrono::microseconds(cost));
+    }
+
+    void BQ25798Sim::fire_pending_interrupt()
+    {
+        InterruptHandler handler = nullptr;
+        void *ctx = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            if (!int_pending_)
+                return;
+            int_pending_ = false;
+            counters_.interrupts++;
+            handler = int_handler_;
+            ctx = int_ctx_;
+        }
+        if (handler != nullptr)
+            handler(ctx);
+    }
+
+    bool BQ25798Sim::is_writable(uint8_t reg)
+    {
+        return reg <= 0x18 || (reg >= REG_CHARGER_MASK0 && reg <= REG_ADC_DISABLE1) || reg == 0x47;
+    }
+
+    bool BQ25798Sim::is_flag(uint8_t reg)
+    {
+        return reg >= REG_CHARGER_FLAG0 && reg <= REG_FAULT_FLAG1;
+    }
+
+} // namespace bq2579x
@@ -0,0 +1,83 @@
+#include <cstdio>
+
+#include "bench.hpp"
+#include "ctrl/bq2579x-adc_batch.hpp"
+#include "ctrl/bq2579x-ctrl_types.hpp"
+
+using namespace bq2579x;
+
+namespace
+{
+    constexpr size_t VALUES = 4096;
+    constexpr uint32_t ROUNDS = 2000;
+
+    uint16_t raw[VALUES];
+    int32_t out_register[VALUES];
+    int32_t out_batch[VALUES];
+
+    // Une valeur à la fois par la classe registre, comme un appelant qui décode échantillon par échantillon
+    template <typename Register>
+    __attribute__((noinline)) void per_register(const uint16_t *in, int32_t *out, size_t n)
+    {
+        Register reg;
+        for (size_t i = 0; i < n; ++i)
+        {
+            reg.set_raw(in[i]);
+            out[i] = static_cast<int32_t>(reg.get_value());
+        }
+    }
+
+    template <typename Convert>
+    double ns_per_value(Convert convert)
+    {
+        convert(); // premier passage hors mesure
+        const uint64_t start = bench::now_ns();
+        for (uint32_t r = 0; r < ROUNDS; ++r)
+        {
+            convert();
+            __asm__ __volatile__("" ::: "memory"); // chaque tour est réellement calculé
+        }
+        return static_cast<double>(bench::now_ns() - start) / (static_cast<double>(ROUNDS) * VALUES);
+    }
+
+    bool same_output()
+    {
+        for (size_t i = 0; i < VALUES; ++i)
+        {
+            if (out_register[i] != out_batch[i])
+                return false;
+        }
+        return true;
+    }
+
+    template <typename Register>
+    void compare(const char *label, void (*batch)(const uint16_t *, int32_t *, size_t))
+    {
+        const double reg_ns = ns_per_value([] { per_register<Register>(raw, out_register, VALUES); });
+        const double batch_ns = ns_per_value([batch] { batch(raw, out_batch, VALUES); });
+        printf("  %-6s get_value() %6.3f ns   lot %6.3f ns   %s\n", label, reg_ns, batch_ns,
+               same_output() ? "identiques" : "DIFFÉRENTS");
+    }
+}
+
+namespace bench
+{
+    void adc_batch()
+    {
+        uint32_t seed = 1;
+        for (size_t i = 0; i < VALUES; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            raw[i] = static_cast<uint16_t>(seed >> 16);
+        }
+
+        printf("Conversion brut → unité par valeur (%lu valeurs, horloge de l'hôte) :\n",
+               static_cast<unsigned long>(VALUES));
+        compare<TS_ADC_Register>("TS", [](const uint16_t *in, int32_t *out, size_t n)
+                                 { adc_ts_milli_pct_batch(in, out, n); });
+        compare<TDIE_ADC_Register>("TDIE", [](const uint16_t *in, int32_t *out, size_t n)
+                                   { adc_tdie_dc_batch(in, out, n); });
+        compare<IBAT_ADC_Register>("IBAT", [](const uint16_t *in, int32_t *out, size_t n)
+                                   { adc_ibat_ma_batch(in, out, n); });
+    }
+}
@@ -0,0 +1,75 @@
+#include <cstdio>
+
+#include "bench.hpp"
+#include "bq25798-sim.hpp"
+#include "ctrl/bq2579x-ctrl.hpp"
+
+using namespace bq2579x;
+
+namespace
+{
+    constexpr uint32_t ITERATIONS = 1000;
+
+    struct Result
+    {
+        uint32_t transactions;
+        uint32_t bytes;
+        uint64_t bus_us;
+    };
+
+    // Coût d'une mesure complète (ICO + 11 voies ADC) sur le bus simulé
+    template <typename Measure>
+    Result run(BQ25798Sim &sim, Measure measure)
+    {
+        sim.reset_counters();
+        const uint64_t start_us = sim.now_us();
+        for (uint32_t i = 0; i < ITERATIONS; ++i)
+            measure();
+        const BQ25798Sim::Counters c = sim.counters();
+        return {c.reads / ITERATIONS, c.bytes_read / ITERATIONS, (sim.now_us() - start_us) / ITERATIONS};
+    }
+
+    void print(const char *label, const Result &r)
+    {
+        printf("  %-14s %3lu transactions %4lu octets %6llu us\n", label,
+               static_cast<unsigned long>(r.transactions), static_cast<unsigned long>(r.bytes),
+               static_cast<unsigned long long>(r.bus_us));
+    }
+}
+
+namespace bench
+{
+    void adc_read()
+    {
+        BQ25798Sim sim;
+        // 100 kHz : ~90 us par octet, START/adresse/registre/STOP en plus à chaque transaction
+        BQ25798Sim::Latency latency;
+        latency.per_transaction_us = 300;
+        latency.per_byte_us = 90;
+        sim.set_latency(latency);
+
+        CTRL ctrl(sim);
+        ctrl.en_adc();
+        sim.advance_us(1000000);
+
+        const Result burst = run(sim, [&] { ctrl.get(); });
+        const Result per_register = run(sim, [&] {
+            ctrl.get_ico_current_limit();
+            ctrl.get_ibus_adc();
+            ctrl.get_ibat_adc();
+            ctrl.get_vbus_adc();
+            ctrl.get_vac1_adc();
+            ctrl.get_vacd2_adc();
+            ctrl.get_vbat_adc();
+            ctrl.get_vsys_adc();
+            ctrl.get_ts_adc();
+            ctrl.get_tdie_adc();
+            ctrl.get_dplus_adc();
+            ctrl.get_dminus_adc();
+        });
+
+        printf("CTRL::get() par mesure (%lu mesures) :\n", static_cast<unsigned long>(ITERATIONS));
+        print("rafale", burst);
+        print("par registre", per_register);
+    }
+}
@@ -0,0 +1,58 @@
+#include <cstdio>
+
+#include "bench.hpp"
+#include "bq2579x-filter.hpp"
+
+using namespace bq2579x;
+
+namespace
+{
+    constexpr uint32_t SAMPLES = 200000;
+
+    // Coût de apply() par échantillon (verrou compris), entrée bruitée sur les voies valides
+    double run(ADC_FILTER_BANK &bank, uint16_t valid)
+    {
+        ADCSample sample;
+        sample.valid = valid;
+        uint32_t noise = 12345;
+        volatile int32_t sink = 0;
+
+        const uint64_t start = bench::now_ns();
+        for (uint32_t n = 0; n < SAMPLES; ++n)
+        {
+            noise = noise * 1103515245u + 12345u;
+            for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+                sample.value[i] = 1000 + static_cast<int32_t>((noise >> 16) & 0xFF);
+            bank.apply(sample);
+            sink = sink + sample.value[static_cast<size_t>(ADCChannel::IBAT)];
+        }
+        return static_cast<double>(bench::now_ns() - start) / SAMPLES;
+    }
+
+    void single(const char *label, const FilterSpec &spec)
+    {
+        ADC_FILTER_BANK bank;
+        bank.configure(ADCChannel::IBUS, FilterSpec::none());
+        bank.configure(ADCChannel::IBAT, spec);
+        printf("  %-22s %6.1f ns\n", label, run(bank, adc_channel_bit(ADCChannel::IBAT)));
+    }
+}
+
+namespace bench
+{
+    void filter()
+    {
+        printf("ADC_FILTER_BANK::apply() par échantillon (%lu échantillons, horloge de l'hôte) :\n",
+               static_cast<unsigned long>(SAMPLES));
+        single("aucun filtre", FilterSpec::none());
+        single("moyenne glissante 16", FilterSpec::moving_average(16));
+        single("médiane 5", FilterSpec::median(5));
+        single("médiane 15", FilterSpec::median(15));
+        single("IIR 1/2^4", FilterSpec::iir(4));
+        single("CIC ordre 2 / 8", FilterSpec::cic(2, 8));
+        single("CIC ordre 4 / 8", FilterSpec::cic(4, 8));
+
+        ADC_FILTER_BANK defaults;
+        printf("  %-22s %6.1f ns\n", "Kconfig, 11 voies", run(defaults, ADC_ALL_CHANNELS));
+    }
+}
@@ -0,0 +1,105 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "bench.hpp"
+#include "bq25798-sim.hpp"
+#include "bq2579x-json_writer.hpp"
+#include "config/bq2579x-config_macro.hpp"
+#include "ctrl/bq2579x-ctrl.hpp"
+#include "status/bq2579x-status.hpp"
+
+using namespace bq2579x;
+
+namespace
+{
+    constexpr uint32_t ITERATIONS = 20000;
+
+    std::atomic<uint64_t> allocations{0};
+}
+
+// Compte toutes les allocations du programme ; le bench ne démarre aucune tâche
+void *operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+namespace
+{
+    struct Result
+    {
+        double allocations;
+        double ns;
+        size_t bytes;
+    };
+
+    template <typename Serialize>
+    Result run(Serialize serialize)
+    {
+        size_t bytes = serialize(); // premier appel hors mesure
+        const uint64_t allocs = allocations.load();
+        const uint64_t start = bench::now_ns();
+        for (uint32_t i = 0; i < ITERATIONS; ++i)
+            bytes = serialize();
+        const uint64_t elapsed = bench::now_ns() - start;
+        return {static_cast<double>(allocations.load() - allocs) / ITERATIONS,
+                static_cast<double>(elapsed) / ITERATIONS, bytes};
+    }
+
+    void print(const char *label, const Result &r)
+    {
+        printf("  %-22s %5zu octets %7.1f allocations %8.0f ns\n", label, r.bytes, r.allocations, r.ns);
+    }
+
+    // to_json(), buffer fixe et flux vers un sink (UART, socket...)
+    template <typename T>
+    void measure(const char *name, const T &obj)
+    {
+        static char buffer[4096];
+        static volatile size_t sunk = 0;
+
+        printf("%s :\n", name);
+        print("to_json()", run([&] { return obj.to_json().size(); }));
+        print("write_json(buffer)", run([&] {
+                  JsonWriter w(buffer, sizeof(buffer));
+                  obj.write_json(w);
+                  return w.size();
+              }));
+        print("write_json(sink)", run([&] {
+                  JsonWriter w([](const char *, size_t len, void *) { sunk = sunk + len; }, nullptr);
+                  obj.write_json(w);
+                  return w.size();
+              }));
+    }
+}
+
+namespace bench
+{
+    void json()
+    {
+        BQ25798Sim sim;
+        STATUS status(sim);
+        CTRL ctrl(sim);
+
+        sim.set_adc_input(0x3B, 7400); // VBAT
+        sim.set_adc_input(0x41, 50);   // TDIE
+        ctrl.en_adc();
+        sim.advance_us(1000000);
+        ctrl.get();
+        status.get_status();
+        const ConfigParams params = load_config_from_kconfig();
+
+        printf("Sérialisation JSON par appel (%lu appels, horloge de l'hôte) :\n",
+               static_cast<unsigned long>(ITERATIONS));
+        measure("CTRL", ctrl);
+        measure("STATUS", status);
+        measure("ConfigParams", params);
+    }
+}
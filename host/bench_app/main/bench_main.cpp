@@ -0,0 +1,12 @@
+#include <cstdlib>
+
+#include "bench.hpp"
+
+extern "C" void app_main(void)
+{
+    bench::adc_read();
+    bench::adc_batch();
+    bench::filter();
+    bench::json();
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdio>
+
+namespace test
+{
+    /// Vérifications en échec, toutes suites confondues
+    extern int failures;
+
+    void filter();
+    void json();
+    void manager();
+}
+
+#define CHECK(cond)                                                    \
+    do                                                                 \
+    {                                                                  \
+        if (!(cond))                                                   \
+        {                                                              \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);     \
+            test::failures++;                                          \
+        }                                                              \
+    } while (0)
@@ -0,0 +1,119 @@
+#include "bq2579x-filter.hpp"
+#include "test.hpp"
+
+using namespace bq2579x;
+
+namespace
+{
+    constexpr ADCChannel CH = ADCChannel::IBAT;
+
+    // Passe une valeur par la voie filtrée ; retourne la sortie
+    int32_t push(ADC_FILTER_BANK &bank, int32_t x)
+    {
+        ADCSample sample;
+        sample.valid = adc_channel_bit(CH);
+        sample.value[static_cast<size_t>(CH)] = x;
+        bank.apply(sample);
+        return sample.get(CH);
+    }
+
+    ADC_FILTER_BANK make_bank(const FilterSpec &spec)
+    {
+        ADC_FILTER_BANK bank;
+        // Voies Kconfig désactivées : seule la voie testée occupe l'arène
+        CHECK(bank.configure(ADCChannel::IBUS, FilterSpec::none()) == ESP_OK);
+        CHECK(bank.configure(CH, spec) == ESP_OK);
+        return bank;
+    }
+
+    void test_moving_average()
+    {
+        ADC_FILTER_BANK bank = make_bank(FilterSpec::moving_average(4));
+        // Fenêtre partielle au démarrage, puis moyenne arrondie des 4 dernières
+        CHECK(push(bank, 100) == 100);
+        CHECK(push(bank, 200) == 150);
+        CHECK(push(bank, 300) == 200);
+        CHECK(push(bank, 400) == 250);
+        CHECK(push(bank, 500) == 350);
+        CHECK(push(bank, -1000) == 50);
+    }
+
+    void test_median()
+    {
+        ADC_FILTER_BANK bank = make_bank(FilterSpec::median(5));
+        for (int i = 0; i < 5; ++i)
+            push(bank, 1000);
+        // Pointe isolée rejetée ; tant qu'elle reste dans la fenêtre elle compte parmi les hautes valeurs
+        CHECK(push(bank, 30000) == 1000);
+        CHECK(push(bank, 1000) == 1000);
+        CHECK(push(bank, 2000) == 1000);
+        CHECK(push(bank, 2000) == 2000);
+    }
+
+    void test_iir()
+    {
+        // Décalage maximal : la sortie doit atteindre l'entrée, pas se figer à quelques LSB
+        ADC_FILTER_BANK bank = make_bank(FilterSpec::iir(FilterSpec::MAX_IIR_SHIFT));
+        CHECK(push(bank, 0) == 0);
+        int32_t y = 0;
+        for (int i = 0; i < 600000; ++i)
+            y = push(bank, 1000);
+        CHECK(y == 1000);
+        for (int i = 0; i < 600000; ++i)
+            y = push(bank, -3);
+        CHECK(y == -3);
+
+        ADC_FILTER_BANK fast = make_bank(FilterSpec::iir(1));
+        CHECK(push(fast, 0) == 0);
+        CHECK(push(fast, 1000) == 500);
+        CHECK(push(fast, 1000) == 750);
+    }
+
+    void test_cic()
+    {
+        ADC_FILTER_BANK bank = make_bank(FilterSpec::cic(2, 4));
+        // Entrée constante : sortie maintenue pendant le transitoire (order sorties), puis gain unité
+        int32_t y = 0;
+        for (int i = 0; i < 12; ++i)
+        {
+            y = push(bank, -250);
+            CHECK(y == -250);
+        }
+        // Nouveau palier : une sortie toutes les 4 entrées, maintenue entre deux
+        int32_t outputs[16];
+        for (int i = 0; i < 16; ++i)
+            outputs[i] = push(bank, 750);
+        for (int i = 0; i < 16; ++i)
+        {
+            if ((i + 1) % 4 != 0)
+                CHECK(outputs[i] == (i < 3 ? -250 : outputs[i - (i % 4) - 1]));
+        }
+        CHECK(outputs[3] > -250 && outputs[3] < 750);
+        CHECK(outputs[15] == 750);
+
+        // Croissance au-delà de CIC_GROWTH_BITS refusée
+        ADC_FILTER_BANK other;
+        CHECK(other.configure(CH, FilterSpec::cic(4, 255)) == ESP_ERR_INVALID_ARG);
+    }
+
+    void test_invalid_channels_untouched()
+    {
+        ADC_FILTER_BANK bank = make_bank(FilterSpec::moving_average(2));
+        push(bank, 100);
+        ADCSample sample;
+        sample.valid = 0; // voie non lue : ni filtrée ni avancée
+        sample.value[static_cast<size_t>(CH)] = 5000;
+        bank.apply(sample);
+        CHECK(sample.get(CH) == 5000);
+        CHECK(push(bank, 300) == 200);
+    }
+}
+
+void test::filter()
+{
+    test_moving_average();
+    test_median();
+    test_iir();
+    test_cic();
+    test_invalid_channels_untouched();
+}
@@ -0,0 +1,114 @@
+#include <cstring>
+#include <string>
+
+#include "bq25798-sim.hpp"
+#include "bq2579x-json_writer.hpp"
+#include "config/bq2579x-config_macro.hpp"
+#include "ctrl/bq2579x-ctrl.hpp"
+#include "status/bq2579x-status.hpp"
+#include "test.hpp"
+
+using namespace bq2579x;
+
+namespace
+{
+    // Sorties de référence : toute différence d'un octet casse les clients qui analysent ces JSON
+    const char *const STATUS_JSON =
+        R"json({"charger_status0": {"value": 1,"iindpm": false,"vindpm": false,"wd": false,"pg": false,"ac2": false,"ac1": false,"vbus": true},)json"
+        R"json("charger_status1": {"value": 0,"charge_status": "Not Charging","vbus_status": "No Input","bc12_done": false},)json"
+        R"json("charger_status2": {"value": 0,"ico_status": "Disabled","treg": false,"dpdm": false,"vbat": false},)json"
+        R"json("charger_status3": {"value": 0,"acrb2": false,"acrb1": false,"adc_done": false,"vsys": false,"chg_tmr": false,"trichg_tmr": false,"prechg_tmr": false},)json"
+        R"json("charger_status4": {"value": 0,"vbatotg_low": false,"ts_cold": false,"ts_cool": false,"ts_warm": false,"ts_hot": false},)json"
+        R"json("fault_status0": {"value": 0,"ibat_reg": false,"vbus_ovp": false,"vbat_ovp": false,"ibus_ocp": false,"ibat_ocp": false,"conv_ocp": false,"vac2_ovp": false,"vac1_ovp": false},)json"
+        R"json("fault_status1": {"value": 0,"vsys_short": false,"vsys_ovp": false,"otg_ovp": false,"otg_uvp": false,"tshut": false}})json";
+
+    const char *const CTRL_JSON =
+        R"json({"ico_current_ma": 0,"ibus_ma": 0,"ibat_ma": -250,)json"
+        R"json("vbus_mv": 0,"vac1_mv": 0,"vac2_mv": 0,"vbat_mv": 7400,)json"
+        R"json("vsys_mv": 0,"ts_celsius_pct": 0.000000,"tdie_celsius": 25.000000,)json"
+        R"json("dplus_mv": 0,"dminus_mv": 0})json";
+
+    const char *const CONFIG_JSON =
+        R"json({"limit": {"vsysmin_mv": 7000,"vreg_mv": 8400,"ichg_ma": 1000,"vindpm_mv": 7700,"iindpm_ma": 1410,"votg_mv": 5000,"iotg_ma": 3000,"precharge_timer_short": 0},)json"
+        R"json("control": {"pre_charge": {"value": 195,"IPRECHG": 120,"VBAT_LOWV": "71.4% VREG"},)json"
+        R"json("termination": {"value": 5,"REG_RST": 0,"STOP_WD_CHG": 0,"ITERM": 200},)json"
+        R"json("re_charge": {"value": 99,"cell_count": "2 Cells","deglitch_time": "1024ms","vrechg_offset_mv": 150},)json"
+        R"json("timer": {"value": 61,"TOPOFF_TMR": "Disabled","EN_CHG_TMR": 1,"EN_PRECHG": 1,"EN_TRICKLE": 1,"CHG_TMR": "12 h","TMR2X_EN": 1},)json"
+        R"json("charger": {"charger_control0": {"value": 162,"EN_AUTO_IBATDIS": 1,"FORCE_IBATDIS": 0,"EN_CHG": 1,"EN_ICO": 0,"FORCE_ICO": 0,"EN_HIZ": 0,"EN_TERM": 1,"EN_BACKUP": 0},)json"
+        R"json("charger_control1": {"value": 133,"VBUS_BACKUP": "80% VINDPM","VAC_OVP": "26 V","WD_RST": 0,"WATCHDOG": "40 s"},)json"
+        R"json("charger_control2": {"value": 64,"FORCE_INDET": 0,"AUTO_INDET_EN": 1,"EN_12V": 0,"EN_9V": 0,"HVDCP_EN": 0,"SDRV_CTRL": "Idle","SDRV_DLY": 0},)json"
+        R"json("charger_control3": {"value": 0,"DIS_ACDRV": 0,"EN_OTG": 0,"PFM_OTG_DIS": 0,"PFM_FWD_DIS": 0,"WKUP_DLY": "1 s","DIS_LDO": 0,"DIS_OTG_OOA": 0,"DIS_FWD_OOA": 0},)json"
+        R"json("charger_control4": {"value": 33,"EN_ACDRV2": 0,"EN_ACDRV1": 0,"PWM_750KHZ": 1,"DIS_STAT": 0,"DIS_VSYS_SHORT": 0,"DIS_VOTG_UVP": 0,"FORCE_VINDPM": 0,"EN_IBUS_OCP": 1},)json"
+        R"json("charger_control5": {"value": 30,"SFET_PRESENT": 0,"EN_IBAT": 0,"EN_IINDPM": 1,"EN_EXTILIM": 1,"EN_BATOC": 0,"IBAT_REG": "6 A"}},)json"
+        R"json("mppt": {"value": 170,"VOC_PCT": "87.5%","VOC_DLY": "300 ms","VOC_RATE": "2 min","EN_MPPT": 0},)json"
+        R"json("temperature": {"value": 192,"THERM_REG": "120 °C","THERM_SHDN": "150 °C","VBUS_PD_EN": 0,"VAC1_PD_EN": 0,"VAC2_PD_EN": 0,"BKUP_ACFET1_ON": 0},)json"
+        R"json("ntc": {"ntc_control0": {"value": 122,"JEITA_VSET": "VREG -400 mV","JEITA_ISETH": "Unchanged","JEITA_ISETC": "20%"},)json"
+        R"json("ntc_control1": {"value": 84,"TS_COOL": "68.4% (~10°C)","TS_WARM": "44.8% (~45°C)","BHOT": "60°C","BCOLD": "-10°C","TS_IGNORE": 0}},)json"
+        R"json("dpdm": {"value": 0,"DP_LEVEL": "Hi-Z","DM_LEVEL": "Hi-Z"}},)json"
+        R"json("mask": {"charger_mask": {"charger_mask0": {"value": 0,"IINDPM_MASK": 0,"VINDPM_MASK": 0,"WD_MASK": 0,"POORSRC_MASK": 0,"PG_MASK": 0,"AC2_PRESENT_MASK": 0,"AC1_PRESENT_MASK": 0,"VBUS_PRESENT_MASK": 0},)json"
+        R"json("charger_mask1": {"value": 0,"CHG_MASK": 0,"ICO_MASK": 0,"VBUS_MASK": 0,"TREG_MASK": 0,"VBAT_PRESENT_MASK": 0,"BC1_2_DONE_MASK": 0},)json"
+        R"json("charger_mask2": {"value": 0,"DPDM_DONE_MASK": 0,"ADC_DONE_MASK": 0,"VSYS_MASK": 0,"CHG_TMR_MASK": 0,"TRICHG_TMR_MASK": 0,"PRECHG_TMR_MASK": 0,"TOPOFF_TMR_MASK": 0},)json"
+        R"json("charger_mask3": {"value": 0,"VBATOTG_LOW_MASK": 0,"TS_COLD_MASK": 0,"TS_COOL_MASK": 0,"TS_WARM_MASK": 0,"TS_HOT_MASK": 0}},)json"
+        R"json("fault_mask": {"fault_mask0": {"value": 0,"IBAT_REG_MASK": 0,"VBUS_OVP_MASK": 0,"VBAT_OVP_MASK": 0,"IBUS_OCP_MASK": 0,"IBAT_OCP_MASK": 0,"CONV_OCP_MASK": 0,"VAC2_OVP_MASK": 0,"VAC1_OVP_MASK": 0},)json"
+        R"json("fault_mask1": {"value": 0,"VSYS_SHORT_MASK": 0,"VSYS_OVP_MASK": 0,"OTG_OVP_MASK": 0,"OTG_UVP_MASK": 0,"TSHUT_MASK": 0}}},)json"
+        R"json("adc": {"control": {"value": 80,"EN": 0,"OS": 1,"RES": 1,"AVG_EN": 0,"AVG_INIT": 0},)json"
+        R"json("function_disable": {"disable0": {"value": 0,"IBUS": 0,"IBAT": 0,"VBUS": 0,"VBAT": 0,"VSYS": 0,"TS": 0,"TDIE": 0},)json"
+        R"json("disable1": {"value": 0,"DP": 0,"DM": 0,"VAC2": 0,"VAC1": 0}}}})json";
+
+    // Le buffer, le flux et to_json() produisent le même texte que la référence
+    template <typename T>
+    void check_golden(const T &obj, const char *golden)
+    {
+        CHECK(obj.to_json() == golden);
+
+        static char buffer[4096];
+        JsonWriter w(buffer, sizeof(buffer));
+        obj.write_json(w);
+        CHECK(!w.overflow());
+        CHECK(w.size() == strlen(golden));
+        CHECK(strcmp(buffer, golden) == 0);
+
+        // Buffer trop petit : texte tronqué terminé par '\0', taille complète annoncée
+        char small[16];
+        JsonWriter t(small, sizeof(small));
+        obj.write_json(t);
+        CHECK(t.overflow());
+        CHECK(t.size() == strlen(golden));
+        CHECK(strncmp(small, golden, sizeof(small) - 1) == 0 && small[sizeof(small) - 1] == '\0');
+    }
+
+    void test_status_json()
+    {
+        BQ25798Sim sim;
+        STATUS status(sim);
+        sim.set_status(0x1B, 0x01); // VBUS_PRESENT_STAT
+        CHECK(status.get_status() == ESP_OK);
+        check_golden(status, STATUS_JSON);
+    }
+
+    void test_ctrl_json()
+    {
+        BQ25798Sim sim;
+        CTRL ctrl(sim);
+        sim.set_adc_input(0x3B, 7400);                        // VBAT
+        sim.set_adc_input(0x41, 50);                          // TDIE, 0,5 °C/LSB
+        sim.set_adc_input(0x33, static_cast<uint16_t>(-250)); // IBAT, décharge
+        CHECK(ctrl.en_adc() == ESP_OK);
+        sim.advance_us(1000000);
+        CHECK(ctrl.get() == ESP_OK);
+        check_golden(ctrl, CTRL_JSON);
+    }
+
+    void test_config_json()
+    {
+        // Valeurs par défaut du Kconfig
+        check_golden(load_config_from_kconfig(), CONFIG_JSON);
+    }
+}
+
+void test::json()
+{
+    test_status_json();
+    test_ctrl_json();
+    test_config_json();
+}
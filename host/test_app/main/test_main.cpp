@@ -0,0 +1,182 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "esp_timer.h"
+
+#include "bq25798-sim.hpp"
+#include "bq2579x-adc_stats.hpp"
+#include "bq2579x-telemetry_frame.hpp"
+#include "config/bq2579x-config.hpp"
+#include "config/bq2579x-config_macro.hpp"
+#include "ctrl/bq2579x-ctrl.hpp"
+#include "status/bq2579x-events.hpp"
+#include "status/bq2579x-status.hpp"
+#include "test.hpp"
+
+using namespace bq2579x;
+
+int test::failures = 0;
+
+namespace
+{
+    void test_part_information()
+    {
+        BQ25798Sim sim;
+        CTRL ctrl(sim);
+        CHECK(ctrl.ready() == ESP_OK);
+    }
+
+    void test_config_write()
+    {
+        BQ25798Sim sim;
+        Config cfg(sim);
+        cfg.datas() = load_config_from_kconfig();
+        cfg.datas().limit.ichg_ma.set_value(1500);
+        CHECK(cfg.set() == ESP_OK);
+        // REG03h..REG04h : ICHG par pas de 10 mA
+        const uint16_t ichg = static_cast<uint16_t>((sim.peek(0x03) << 8) | sim.peek(0x04)) & 0x01FF;
+        CHECK(ichg == 150);
+    }
+
+    void test_flags_to_events()
+    {
+        BQ25798Sim sim;
+        STATUS status(sim);
+
+        sim.set_status(0x1B, 0x01); // VBUS_PRESENT_STAT
+        CHECK(status.get_snapshot() == ESP_OK);
+        CHECK(decode_events(status) == event_bit(ChargerEvent::VBUS_PRESENT));
+        CHECK(status.charger_status0.get_values().vbus_present);
+
+        // Flags effacés par la lecture précédente
+        CHECK(status.get_snapshot() == ESP_OK);
+        CHECK(decode_events(status) == 0);
+
+        // ACRB1_STAT n'a pas de flag : aucun événement
+        sim.set_status(0x1E, 0x40);
+        CHECK(status.get_snapshot() == ESP_OK);
+        CHECK(decode_events(status) == 0);
+
+        sim.set_status(0x20, 0x40); // VBUS_OVP_STAT
+        CHECK(status.get_snapshot() == ESP_OK);
+        CHECK(decode_events(status) == event_bit(ChargerEvent::VBUS_OVP));
+    }
+
+    void test_snapshot_span()
+    {
+        BQ25798Sim sim;
+        STATUS status(sim);
+
+        sim.set_status(0x20, 0x40);
+        CHECK(status.get_snapshot(STATUS::FLAGS_BLOCK_LEN - 2) == ESP_OK);
+        CHECK(decode_events(status) == 0);
+        // Flags hors de la fenêtre lue : toujours levés dans le composant
+        CHECK(sim.peek(0x26) == 0x40);
+    }
+
+    void test_adc()
+    {
+        BQ25798Sim sim;
+        CTRL ctrl(sim);
+
+        sim.set_adc_input(0x3B, 7400); // VBAT
+        sim.set_adc_input(0x41, 50);   // TDIE, 0,5 °C/LSB
+        CHECK(ctrl.en_adc() == ESP_OK);
+        sim.advance_us(1000000);
+        CHECK(ctrl.get() == ESP_OK);
+        CHECK(ctrl.adc_snapshot().value(ADCChannel::VBAT) == 7400);
+        CHECK(ctrl.adc_snapshot().value(ADCChannel::TDIE) == 250);
+    }
+
+    void test_frame_conversions()
+    {
+        // Mêmes conversions que l'instantané ADC, voie par voie
+        TelemetryFrame frame;
+        const uint16_t raws[] = {0, 1, 0x7FFF, 0x8000, 0xFF9C, 0xFFFF};
+        for (uint16_t raw : raws)
+        {
+            for (size_t i = 0; i < TelemetryFrame::ADC_COUNT; ++i)
+                frame.adc_raw[i] = raw;
+            CHECK(frame.ibus_ma() == adc_convert(ADCChannel::IBUS, raw));
+            CHECK(frame.ibat_ma() == adc_convert(ADCChannel::IBAT, raw));
+            CHECK(frame.vbat_mv() == adc_convert(ADCChannel::VBAT, raw));
+            CHECK(frame.ts_milli_pct() == static_cast<uint32_t>(adc_convert(ADCChannel::TS, raw)));
+            CHECK(frame.tdie_dc() == adc_convert(ADCChannel::TDIE, raw));
+        }
+    }
+
+    void test_oneshot()
+    {
+        BQ25798Sim sim;
+        sim.set_wall_clock(true);
+        CTRL ctrl(sim);
+
+        sim.set_adc_input(0x3B, 7400); // VBAT
+        sim.poke(0x2E, 0x70);          // ADC_RATE one-shot, 12 bits : 3 ms par voie
+        const uint32_t expected_us = 11 * 3000;
+        const uint32_t timeout_us = 2 * expected_us + 10000;
+        const int64_t start_us = esp_timer_get_time();
+        CHECK(ctrl.convert_oneshot(expected_us, timeout_us) == ESP_OK);
+        const int64_t elapsed_us = esp_timer_get_time() - start_us;
+        CHECK(elapsed_us >= expected_us && elapsed_us < timeout_us);
+        CHECK(sim.counters().adc_conversions == 1);
+        CHECK(ctrl.get() == ESP_OK);
+        CHECK(ctrl.adc_snapshot().value(ADCChannel::VBAT) == 7400);
+    }
+
+    void test_stats_window_cap()
+    {
+        // Fenêtre sans fermeture périodique, TDIE aux deux extrêmes : variance maximale
+        ADC_STATS stats;
+        stats.configure(adc_channel_bit(ADCChannel::TDIE), 4, 0);
+        ADCSample sample;
+        sample.valid = adc_channel_bit(ADCChannel::TDIE);
+        for (uint32_t i = 0; i < ADC_STATS::MAX_WINDOW_SAMPLES; ++i)
+        {
+            sample.timestamp_us = i;
+            sample.value[static_cast<size_t>(ADCChannel::TDIE)] = (i & 1) ? 163835 : -163840;
+            stats.add(sample);
+        }
+
+        ADCStatsWindow window;
+        CHECK(stats.last_window(window));
+        const ChannelStats &tdie = window.get(ADCChannel::TDIE);
+        CHECK(tdie.count == ADC_STATS::MAX_WINDOW_SAMPLES);
+        CHECK(tdie.m2_q > 0);
+        // Écart type ≈ demi-étendue
+        CHECK(tdie.stddev_q() / ChannelStats::SCALE == 163838);
+    }
+
+    void test_watchdog_expiry()
+    {
+        BQ25798Sim sim;
+        Config cfg(sim);
+        STATUS status(sim);
+        cfg.datas() = load_config_from_kconfig();
+        CHECK(cfg.set() == ESP_OK);
+
+        sim.advance_us(41000000); // watchdog 40 s
+        CHECK(status.get_flags() == ESP_OK);
+        CHECK(status.charger_flag0.get_values().wd_flag);
+        CHECK(sim.counters().watchdog_expirations == 1);
+    }
+}
+
+extern "C" void app_main(void)
+{
+    test_part_information();
+    test_config_write();
+    test_flags_to_events();
+    test_snapshot_span();
+    test_adc();
+    test_frame_conversions();
+    test_oneshot();
+    test_stats_window_cap();
+    test_watchdog_expiry();
+    test::filter();
+    test::json();
+    test::manager();
+
+    printf("%s (%d échec(s))\n", test::failures ? "FAILED" : "OK", test::failures);
+    exit(test::failures ? EXIT_FAILURE : EXIT_SUCCESS);
+}
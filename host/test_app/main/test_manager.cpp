@@ -0,0 +1,330 @@
+#include <atomic>
+
+#include "bq25798-sim.hpp"
+#include "bq2579x.hpp"
+#include "config/bq2579x-config_macro.hpp"
+#include "bq2579x-port.hpp"
+#include "test.hpp"
+
+using namespace bq2579x;
+
+namespace
+{
+    // Le gestionnaire et sa tâche vivent jusqu'à la fin du programme : une seule instance
+    BQ25798Sim sim;
+
+    uint16_t ichg_raw()
+    {
+        // REG03h..REG04h : ICHG par pas de 10 mA
+        return static_cast<uint16_t>((sim.peek(0x03) << 8) | sim.peek(0x04)) & 0x01FF;
+    }
+
+    void set_ichg_raw(uint16_t raw)
+    {
+        sim.poke(0x03, static_cast<uint8_t>(raw >> 8));
+        sim.poke(0x04, static_cast<uint8_t>(raw));
+    }
+
+    template <typename Predicate>
+    bool wait_for(Predicate done, uint32_t timeout_ms)
+    {
+        for (uint32_t waited = 0; waited < timeout_ms; waited += 10)
+        {
+            if (done())
+                return true;
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+        return done();
+    }
+
+    void test_init(BQ2579XManager &manager)
+    {
+        set_ichg_raw(50);
+        manager.init();
+        // Configuration Kconfig écrite par la tâche du gestionnaire
+        CHECK(wait_for([] { return ichg_raw() == CONFIG_BQ25798_ICHG_MA / 10; }, 2000));
+    }
+
+    void test_alert_dispatch(BQ2579XManager &manager)
+    {
+        static std::atomic<uint64_t> received{0};
+        CHECK(manager.events().subscribe(event_bit(ChargerEvent::VBUS_PRESENT),
+                                         [](const ChargerEventMessage &msg, void *)
+                                         { received.fetch_or(msg.events); },
+                                         nullptr) == ESP_OK);
+
+        sim.set_status(0x1B, 0x01); // VBUS_PRESENT_STAT : flag levé, INT simulée
+        CHECK(wait_for([] { return received.load() & event_bit(ChargerEvent::VBUS_PRESENT); }, 1000));
+    }
+
+    void test_watchdog_rewrite()
+    {
+        // Registres revenus aux valeurs par défaut puis WD_FLAG : la boucle réécrit la configuration
+        set_ichg_raw(50);
+        sim.raise_flags(0x22, 0x20);
+        CHECK(wait_for([] { return ichg_raw() == CONFIG_BQ25798_ICHG_MA / 10; }, 1000));
+    }
+
+    void test_unmask_discards_latched_flags(BQ2579XManager &manager)
+    {
+        static std::atomic<uint64_t> received{0};
+        CHECK(manager.events().subscribe(event_bit(ChargerEvent::VSYS_OVP) | event_bit(ChargerEvent::VBUS_PRESENT),
+                                         [](const ChargerEventMessage &msg, void *)
+                                         { received.fetch_or(msg.events); },
+                                         nullptr) == ESP_OK);
+
+        // FAULT_FLAG1 entièrement masqué : hors de la fenêtre lue à chaque alerte
+        static Config cfg(sim);
+        cfg.datas() = load_config_from_kconfig();
+        cfg.datas().mask.fault_mask.fault_mask1.set_raw(0xFF);
+        CHECK(manager.apply_config(cfg) == ESP_OK);
+
+        sim.raise_flags(0x27, 0x40); // VSYS_OVP_FLAG, masqué : pas d'INT, reste levé
+        vTaskDelay(pdMS_TO_TICKS(50));
+        CHECK(sim.peek(0x27) == 0x40);
+
+        // Démasquage : l'ancien flag est effacé, pas servi comme un événement neuf
+        cfg.datas() = load_config_from_kconfig();
+        CHECK(manager.apply_config(cfg) == ESP_OK);
+        CHECK(sim.peek(0x27) == 0);
+
+        received.store(0);
+        sim.raise_flags(0x22, 0x01); // VBUS_PRESENT_FLAG : alerte lue sur toute la fenêtre
+        CHECK(wait_for([] { return received.load() & event_bit(ChargerEvent::VBUS_PRESENT); }, 1000));
+        CHECK(!(received.load() & event_bit(ChargerEvent::VSYS_OVP)));
+    }
+
+    void test_telemetry(BQ2579XManager &manager)
+    {
+        static TelemetryFrame frame;
+        static uint32_t frames = 0;
+        manager.set_telemetry_sink([](const uint8_t *data, size_t len, void *)
+                                   {
+                                       if (TelemetryFrame::decode(data, len, frame) == TelemetryFrame::DecodeResult::Ok)
+                                           frames++;
+                                   });
+        sim.set_adc_input(0x3B, 7400); // VBAT
+
+        const int64_t before_us = esp_timer_get_time();
+        CHECK(manager.get_measurements(OutputFormat::Binary) == ESP_OK);
+        CHECK(frames == 1);
+        // Datée de la lecture ADC, pas de l'envoi
+        CHECK(frame.timestamp_us >= static_cast<uint64_t>(before_us));
+        CHECK(frame.is_valid(TelemetryFrame::VBAT));
+
+        // Statuts seuls : aucune voie ADC reprise d'une lecture antérieure
+        vTaskDelay(pdMS_TO_TICKS(20));
+        const uint64_t adc_us = frame.timestamp_us;
+        CHECK(manager.get_status(OutputFormat::Binary) == ESP_OK);
+        CHECK(frames == 2);
+        CHECK(frame.adc_valid == 0);
+        CHECK(frame.vbat_mv() == 0);
+        CHECK(frame.timestamp_us > adc_us);
+        manager.set_telemetry_sink(nullptr);
+    }
+
+    void test_streaming(BQ2579XManager &manager)
+    {
+        constexpr uint32_t PERIOD_MS = 10;
+        constexpr uint32_t DURATION_MS = 500;
+        sim.set_adc_input(0x3B, 7400); // VBAT
+
+        // Période imposée : pas de mode ADC choisi par l'état de charge
+        CHECK(manager.set_adaptive_adc(false) == ESP_OK);
+        SampleCursor cursor = manager.stream().cursor();
+        const int64_t start_us = esp_timer_get_time();
+        CHECK(manager.start_streaming(PERIOD_MS) == ESP_OK);
+        CHECK(manager.streaming());
+        vTaskDelay(pdMS_TO_TICKS(DURATION_MS));
+        manager.stop_streaming();
+        const int64_t elapsed_us = esp_timer_get_time() - start_us;
+        CHECK(!manager.streaming());
+
+        const StreamStats stats = manager.get_stream_stats();
+        printf("streaming : %lu échantillons en %lld ms (%.1f/s), lecture max %lu us, %lu périodes en retard\n",
+               static_cast<unsigned long>(stats.samples), static_cast<long long>(elapsed_us / 1000),
+               stats.samples * 1e6 / elapsed_us, static_cast<unsigned long>(stats.max_read_us),
+               static_cast<unsigned long>(stats.late_periods));
+        CHECK(stats.read_errors == 0);
+        // Cadence tenue à la moitié près : l'hôte n'est pas temps réel
+        CHECK(stats.samples >= DURATION_MS / PERIOD_MS / 2);
+        CHECK(stats.samples <= DURATION_MS / PERIOD_MS + 2);
+
+        // Les premières lectures précèdent la fin de la première conversion continue
+        ADCSample sample;
+        int32_t last_vbat = 0;
+        uint32_t read = 0;
+        while (manager.stream().read(cursor, sample))
+        {
+            read++;
+            last_vbat = sample.get(ADCChannel::VBAT);
+        }
+        CHECK(read == stats.samples);
+        CHECK(last_vbat == 7400);
+
+        // Arrêt acquitté : plus aucun échantillon ensuite
+        vTaskDelay(pdMS_TO_TICKS(5 * PERIOD_MS));
+        CHECK(manager.get_stream_stats().samples == stats.samples);
+    }
+
+    void test_rate_groups(BQ2579XManager &manager)
+    {
+        static const ADCRateGroup thermal[] = {
+            {adc_channel_bit(ADCChannel::TS) | adc_channel_bit(ADCChannel::TDIE), 1000}};
+#ifdef CONFIG_BQ25798_RATE_GROUPS
+        CHECK(manager.set_adc_rate_groups(thermal, 1) == ESP_OK);
+        CHECK(manager.set_adc_rate_groups(thermal, ADC_RATE_GROUPS::MAX_GROUPS + 1) == ESP_ERR_INVALID_ARG);
+#else
+        // Groupes jamais appliqués sans l'option : l'appelant doit le savoir
+        CHECK(manager.set_adc_rate_groups(thermal, 1) == ESP_ERR_NOT_SUPPORTED);
+#endif
+    }
+
+#ifdef CONFIG_BQ25798_ENERGY
+    void test_energy_save(BQ2579XManager &manager)
+    {
+        static std::atomic<uint32_t> saves{0};
+        static std::atomic<bool> off_loop{false};
+        static TaskHandle_t caller;
+        caller = xTaskGetCurrentTaskHandle();
+
+        EnergyStorage storage;
+        storage.save = [](const EnergyCounters &, void *)
+        {
+            // Sauvegarde faite par la tâche du gestionnaire, pas par l'appelant
+            if (xTaskGetCurrentTaskHandle() == caller)
+                off_loop.store(true);
+            saves++;
+            return ESP_OK;
+        };
+        manager.energy().set_storage(storage);
+        manager.energy().set_save_interval_us(100000);
+
+        CHECK(manager.start_streaming(10) == ESP_OK);
+        vTaskDelay(pdMS_TO_TICKS(500));
+        manager.stop_streaming();
+        CHECK(saves.load() >= 3 && saves.load() <= 6);
+        CHECK(!off_loop.load());
+        CHECK(!manager.energy().save_pending());
+
+        manager.energy().set_storage(EnergyStorage());
+    }
+#endif
+
+    void test_adc_plan(BQ2579XManager &manager)
+    {
+        // Configuration passée par une autre tâche pendant que la boucle lit l'ADC
+        static Config cfg(sim);
+        cfg.datas() = load_config_from_kconfig();
+        ADCFunctionDisable0Register::Values d0 = cfg.datas().adc.adc_function_disable.adc_function_disable0.get_values();
+        d0.vbus_adc_disable = true;
+        cfg.datas().adc.adc_function_disable.adc_function_disable0.set_values(d0);
+
+        SampleCursor cursor = manager.stream().cursor();
+        CHECK(manager.start_streaming(10) == ESP_OK);
+        vTaskDelay(pdMS_TO_TICKS(50));
+        CHECK(manager.apply_config(cfg) == ESP_OK);
+        vTaskDelay(pdMS_TO_TICKS(50));
+        manager.stop_streaming();
+
+        // Plan remplacé entre deux échantillons : VBUS lue jusqu'au changement, plus ensuite
+        ADCSample sample;
+        uint32_t with_vbus = 0;
+        uint32_t without_vbus = 0;
+        bool switched = false;
+        bool reverted = false;
+        while (manager.stream().read(cursor, sample))
+        {
+            CHECK(sample.is_valid(ADCChannel::VBAT));
+            if (sample.is_valid(ADCChannel::VBUS))
+            {
+                with_vbus++;
+                reverted |= switched;
+            }
+            else
+            {
+                without_vbus++;
+                switched = true;
+            }
+        }
+        CHECK(with_vbus > 0 && without_vbus > 0);
+        CHECK(!reverted);
+
+        cfg.datas() = load_config_from_kconfig();
+        CHECK(manager.apply_config(cfg) == ESP_OK);
+    }
+
+    void test_concurrent_access(BQ2579XManager &manager)
+    {
+        // Une autre tâche change le mode ADC et relit les statuts pendant que la boucle sert
+        // alertes, réécritures après watchdog et streaming
+        static std::atomic<bool> done{false};
+        static std::atomic<uint32_t> errors{0};
+        xTaskCreate([](void *arg) {
+            BQ2579XManager &m = *static_cast<BQ2579XManager *>(arg);
+            // Mode one-shot 15 bits une fois sur deux : chaque mesure attend sa conversion
+            for (int i = 0; i < 10; ++i)
+            {
+                if (m.set_adaptive_adc(i & 1) != ESP_OK)
+                    errors++;
+                if (m.get_status() != ESP_OK)
+                    errors++;
+                if (m.get_measurements() != ESP_OK)
+                    errors++;
+            }
+            done.store(true);
+            vTaskDelete(nullptr);
+        }, "test_writer", 4096, &manager, 5, nullptr);
+
+        CHECK(manager.start_streaming(5) == ESP_OK);
+        TelemetryFrame frame;
+        // Alertes sous le seuil de la protection contre les rafales : aucune source masquée
+        for (int i = 0; i < 100 && !done.load(); ++i)
+        {
+            if (i % 5 == 0)
+            {
+                set_ichg_raw(50);
+                sim.raise_flags(0x22, 0x20); // WD_FLAG
+            }
+            else
+            {
+                sim.raise_flags(0x22, 0x01);
+            }
+            manager.build_telemetry_frame(frame);
+            vTaskDelay(pdMS_TO_TICKS(100));
+        }
+        // Aucun interblocage entre le verrou d'état, la boucle et stop_streaming()
+        CHECK(done.load());
+        manager.stop_streaming();
+        CHECK(!manager.streaming());
+        CHECK(errors.load() == 0);
+
+        CHECK(manager.set_adaptive_adc(false) == ESP_OK);
+        set_ichg_raw(50);
+        sim.raise_flags(0x22, 0x20);
+        CHECK(wait_for([] { return ichg_raw() == CONFIG_BQ25798_ICHG_MA / 10; }, 1000));
+    }
+}
+
+namespace test
+{
+    void manager()
+    {
+        static BQ2579XManager manager(sim);
+        sim.set_wall_clock(true);
+        sim.set_interrupt_handler(port::simulate_alert, nullptr);
+
+        test_init(manager);
+        test_alert_dispatch(manager);
+        test_watchdog_rewrite();
+        test_unmask_discards_latched_flags(manager);
+        test_telemetry(manager);
+        test_streaming(manager);
+        test_rate_groups(manager);
+#ifdef CONFIG_BQ25798_ENERGY
+        test_energy_save(manager);
+#endif
+        test_adc_plan(manager);
+        test_concurrent_access(manager);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#include "ctrl/bq2579x-adc_channel.hpp"
+
+namespace bq2579x
+{
+    /// Voies lues ensemble à leur propre période ; period_ms = 0 : à chaque tour du streaming
+    struct ADCRateGroup
+    {
+        uint16_t channels;
+        uint32_t period_ms;
+    };
+
+    /**
+     * @class ADC_RATE_GROUPS
+     * @brief Échéancier multi-cadence des voies ADC du streaming.
+     *
+     * À chaque tour, due() rend l'union des groupes échus : une seule rafale
+     * (CTRL::get_adc(channels)) les lit tous. Un groupe dont l'échéance tombe dans
+     * la fenêtre de fusion est avancé plutôt que de coûter un réveil de plus. Les
+     * voies hors de tout groupe sont lues à chaque tour.
+     */
+    class ADC_RATE_GROUPS
+    {
+    public:
+        static constexpr size_t MAX_GROUPS = 4;
+
+        /// Par défaut : TS et TDIE à CONFIG_BQ25798_RATE_THERMAL_PERIOD_MS, le reste à chaque tour (aucun groupe sans CONFIG_BQ25798_RATE_GROUPS)
+        ADC_RATE_GROUPS();
+
+        /// Groupes copiés ; une voie ne peut appartenir qu'à un groupe
+        esp_err_t set_groups(const ADCRateGroup *groups, size_t count);
+
+        /// Voies à lire maintenant ; merge_us : avance tolérée pour fusionner une échéance proche
+        uint16_t due(int64_t now_us, uint32_t merge_us);
+
+        /// Tous les groupes échus au prochain due() (début de streaming)
+        void restart();
+
+        static const ADCRateGroup DEFAULT_GROUPS[];
+        static const size_t DEFAULT_GROUP_COUNT;
+
+    private:
+        mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+        ADCRateGroup groups_[MAX_GROUPS] = {};
+        int64_t next_due_us_[MAX_GROUPS] = {};
+        size_t count_ = 0;
+        uint16_t grouped_ = 0;
+    };
+
+} // namespace bq2579x
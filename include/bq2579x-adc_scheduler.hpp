@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+#include "config/bq2579x-config_adc_types.hpp"
+#include "status/bq2579x-status_types.hpp"
+
+namespace bq2579x
+{
+    /// Mode d'acquisition appliqué pour un état de charge
+    struct ADCSchedule
+    {
+        bool oneshot = true;
+        ADCControlRegister::ADCSampleResolution resolution = ADCControlRegister::ADCSampleResolution::RES_15_BIT;
+        uint32_t period_ms = 1000;
+
+        bool operator==(const ADCSchedule &o) const
+        {
+            return oneshot == o.oneshot && resolution == o.resolution && period_ms == o.period_ms;
+        }
+        bool operator!=(const ADCSchedule &o) const { return !(*this == o); }
+    };
+
+    /// Règle de la table : s'applique si l'état de charge ET l'état VBUS sont dans les masques
+    struct ADCPolicyRule
+    {
+        uint8_t charge_mask;  // bit = ChargerStatus1Register::ChargeStatus
+        uint16_t vbus_mask;   // bit = ChargerStatus1Register::VbusStatus
+        ADCSchedule schedule;
+    };
+
+    constexpr uint8_t charge_bit(ChargerStatus1Register::ChargeStatus s)
+    {
+        return static_cast<uint8_t>(1u << static_cast<uint8_t>(s));
+    }
+
+    constexpr uint16_t vbus_bit(ChargerStatus1Register::VbusStatus s)
+    {
+        return static_cast<uint16_t>(1u << static_cast<uint8_t>(s));
+    }
+
+    static constexpr uint8_t CHARGE_ANY = 0xFF;
+    static constexpr uint16_t VBUS_ANY = 0xFFFF;
+
+    /**
+     * @class ADC_SCHEDULER
+     * @brief Choisit le mode ADC (continu/one-shot, résolution, période) selon l'état du chargeur.
+     *
+     * La première règle dont les deux masques correspondent l'emporte ; sinon le mode
+     * par défaut s'applique. La table est copiée : l'appelant peut la libérer.
+     */
+    class ADC_SCHEDULER
+    {
+    public:
+        static constexpr size_t MAX_RULES = 8;
+
+        ADC_SCHEDULER();
+
+        esp_err_t set_policy(const ADCPolicyRule *rules, size_t count, const ADCSchedule &fallback);
+
+        const ADCSchedule &select(ChargerStatus1Register::ChargeStatus charge,
+                                  ChargerStatus1Register::VbusStatus vbus) const;
+
+        /// Charge rapide : 12 bits continu ; sur batterie au repos : one-shot 15 bits lent
+        static const ADCPolicyRule DEFAULT_RULES[];
+        static const size_t DEFAULT_RULE_COUNT;
+        static const ADCSchedule DEFAULT_FALLBACK;
+
+    private:
+        ADCPolicyRule rules_[MAX_RULES] = {};
+        size_t count_ = 0;
+        ADCSchedule fallback_ = {};
+    };
+
+} // namespace bq2579x
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+
+#include "bq2579x-json_writer.hpp"
+#include "bq2579x-stream.hpp"
+
+namespace bq2579x
+{
+    /// Agrégats d'une voie sur une fenêtre, en virgule fixe (unités de ADCSample × SCALE)
+    struct ChannelStats
+    {
+        // 1/64 d'unité : à pleine dynamique (TDIE, ±163840), m2_q tient ~84 000 échantillons
+        static constexpr int32_t SCALE = 64;
+
+        uint32_t count = 0;
+        int32_t min = INT32_MAX;
+        int32_t max = INT32_MIN;
+        int64_t mean_q = 0; // moyenne × SCALE (Welford)
+        int64_t m2_q = 0;   // Σ (x - moyenne)² × SCALE²
+        int64_t ewma_q = 0; // moyenne exponentielle × SCALE, continue d'une fenêtre à l'autre
+
+        int32_t mean() const { return static_cast<int32_t>(mean_q / SCALE); }
+        int32_t ewma() const { return static_cast<int32_t>(ewma_q / SCALE); }
+
+        /// Variance d'échantillon × SCALE²
+        uint64_t variance_q() const { return count > 1 ? static_cast<uint64_t>(m2_q) / (count - 1) : 0; }
+
+        /// Écart type × SCALE
+        uint32_t stddev_q() const;
+    };
+
+    struct ADCStatsWindow
+    {
+        int64_t start_us = 0; // horodatage du premier échantillon
+        int64_t end_us = 0;   // horodatage du dernier échantillon
+        uint16_t channels = 0; // voies suivies (adc_channel_bit)
+        ChannelStats ch[ADC_CHANNEL_COUNT] = {};
+
+        const ChannelStats &get(ADCChannel c) const { return ch[static_cast<size_t>(c)]; }
+
+        void write_json(JsonWriter &w) const;
+    };
+
+    /**
+     * @class ADC_STATS
+     * @brief Statistiques glissantes par voie (min, max, moyenne, EWMA, variance), mémoire constante.
+     *
+     * Alimentées par le chemin de mesure (get_measurements, streaming). Une fenêtre
+     * se ferme tous les window_samples échantillons (0 : sur read_and_reset, ou à
+     * MAX_WINDOW_SAMPLES) et reste disponible via last_window() jusqu'à la suivante.
+     */
+    class ADC_STATS
+    {
+    public:
+        static constexpr uint16_t DEFAULT_CHANNELS =
+            adc_channel_bit(ADCChannel::IBUS) | adc_channel_bit(ADCChannel::IBAT) |
+            adc_channel_bit(ADCChannel::VBUS) | adc_channel_bit(ADCChannel::VBAT) |
+            adc_channel_bit(ADCChannel::VSYS) | adc_channel_bit(ADCChannel::TS) |
+            adc_channel_bit(ADCChannel::TDIE);
+
+        /// Fenêtre la plus longue : m2_q ne peut pas déborder, même à pleine dynamique
+        static constexpr uint32_t MAX_WINDOW_SAMPLES = 65536;
+
+        /// ewma_shift : coefficient 1 / 2^shift ; window_samples ramené à MAX_WINDOW_SAMPLES
+        void configure(uint16_t channels, uint8_t ewma_shift, uint32_t window_samples);
+
+        /// Ajoute les voies valides de l'échantillon
+        void add(const ADCSample &sample);
+
+        /// Copie la fenêtre courante et en ouvre une nouvelle, atomiquement
+        void read_and_reset(ADCStatsWindow &out);
+
+        /// Dernière fenêtre fermée automatiquement ; false si aucune
+        bool last_window(ADCStatsWindow &out) const;
+
+        /// Oublie fenêtres et EWMA
+        void reset();
+
+    private:
+        mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+        uint16_t channels_ = DEFAULT_CHANNELS;
+        uint8_t ewma_shift_ = CONFIG_BQ25798_ADC_STATS_EWMA_SHIFT;
+        uint32_t window_samples_ = CONFIG_BQ25798_ADC_STATS_WINDOW ? CONFIG_BQ25798_ADC_STATS_WINDOW : MAX_WINDOW_SAMPLES;
+        uint32_t samples_ = 0;
+
+        ADCStatsWindow current_ = {};
+        ADCStatsWindow last_ = {};
+        bool has_last_ = false;
+        uint16_t ewma_started_ = 0;
+
+        void open_window();
+    };
+
+} // namespace bq2579x
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+
+#include "status/bq2579x-events.hpp"
+
+namespace bq2579x
+{
+    /// Interventions de la protection contre les rafales d'alertes
+    struct StormStats
+    {
+        uint32_t alerts = 0;        // alertes traitées
+        uint32_t coalesced = 0;     // alertes reportées par l'intervalle minimal puis traitées ensemble
+        uint32_t masked = 0;        // sources masquées pour dépassement de cadence
+        uint32_t unmasked = 0;      // sources démasquées après back-off
+        uint64_t masked_events = 0; // sources actuellement masquées (event_bit)
+    };
+
+    /**
+     * @class ALERT_GUARD
+     * @brief Détection des sources d'alerte trop fréquentes, sans accès au bus.
+     *
+     * Chaque source (événement) est comptée sur une fenêtre fixe ; au-delà du seuil
+     * elle doit être masquée pendant backoff, puis démasquée. Le gestionnaire applique
+     * les masques (REG28h..REG2Dh) et impose l'intervalle minimal entre deux services.
+     */
+    class ALERT_GUARD
+    {
+    public:
+        void configure(uint32_t min_interval_ms, uint16_t threshold, uint32_t window_ms, uint32_t backoff_ms);
+
+        /// Attente restante avant de pouvoir servir une nouvelle alerte
+        int64_t service_delay_us(int64_t now_us) const;
+
+        /// Comptabilise une alerte ; retourne les sources à masquer maintenant
+        uint64_t record(uint64_t events, int64_t now_us);
+
+        /// Sources dont le back-off a expiré (retirées de masked_events)
+        uint64_t expired(int64_t now_us);
+
+        /// Prochaine échéance de démasquage, INT64_MAX si aucune
+        int64_t next_unmask_us() const;
+
+        void note_coalesced();
+
+        /// Sources qui n'ont finalement pas pu être (dé)masquées ; démasquage retenté après une fenêtre
+        void rollback(uint64_t masked, uint64_t unmasked, int64_t now_us);
+
+        StormStats stats() const;
+
+    private:
+        static constexpr size_t SOURCES = static_cast<size_t>(ChargerEvent::COUNT);
+
+        mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+        int64_t min_interval_us_ = static_cast<int64_t>(CONFIG_BQ25798_ALERT_MIN_INTERVAL_MS) * 1000;
+        uint16_t threshold_ = CONFIG_BQ25798_ALERT_STORM_THRESHOLD;
+        int64_t window_us_ = 1000000;
+        int64_t backoff_us_ = static_cast<int64_t>(CONFIG_BQ25798_ALERT_STORM_BACKOFF_MS) * 1000;
+
+        int64_t last_service_us_ = INT64_MIN / 2;
+        int64_t window_start_us_ = 0;
+        uint16_t counts_[SOURCES] = {};
+        int64_t unmask_at_us_[SOURCES] = {};
+        StormStats stats_ = {};
+    };
+
+} // namespace bq2579x
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "sdkconfig.h"
+
+#include "bq2579x-interface.hpp"
+
+namespace bq2579x
+{
+    enum class AsyncOp : uint8_t
+    {
+        Read,
+        Write,
+        Stop
+    };
+
+    struct AsyncRequest;
+
+    /// Appelé depuis la tâche du bus à la fin de chaque requête (ne doit pas bloquer)
+    using AsyncCallback = void (*)(const AsyncRequest &req, esp_err_t err, void *ctx);
+
+    struct AsyncRequest
+    {
+        static constexpr size_t MAX_WRITE_LEN = 32; // couvre la plus longue écriture en rafale (REG00h..REG18h)
+
+        AsyncOp op = AsyncOp::Read;
+        uint8_t reg = 0;
+        size_t len = 0;
+        uint8_t *data = nullptr;              // lecture : destination, valide jusqu'à la complétion
+        uint8_t payload[MAX_WRITE_LEN] = {};  // écriture : données copiées à la soumission
+        AsyncCallback callback = nullptr;
+        void *ctx = nullptr;
+        TaskHandle_t notify_task = nullptr;   // reçoit xTaskNotifyGive() à la complétion
+        esp_err_t *result = nullptr;          // renseigné avant la notification
+    };
+
+    /**
+     * @class ASYNC_INTERFACE
+     * @brief Accès registres non bloquant : les requêtes sont traitées dans l'ordre
+     *        par une tâche dédiée au bus, l'appelant est prévenu par callback ou notification.
+     *
+     * Les requêtes de CTRL, STATUS et Config s'enchaînent dans la file au lieu
+     * d'être sérialisées sur la pile de l'appelant ; les tentatives et délais de
+     * l'INTERFACE ne bloquent plus que la tâche du bus. Les accès directs des
+     * autres tâches restent possibles : INTERFACE sérialise chaque transaction.
+     */
+    class ASYNC_INTERFACE : public INTERFACE
+    {
+    public:
+        explicit ASYNC_INTERFACE(I2CDevices &dev) : INTERFACE(dev) {}
+        ~ASYNC_INTERFACE();
+
+        ASYNC_INTERFACE(const ASYNC_INTERFACE &) = delete;
+        ASYNC_INTERFACE &operator=(const ASYNC_INTERFACE &) = delete;
+
+        /// Crée la file et la tâche du bus
+        esp_err_t start(size_t queue_depth = CONFIG_BQ25798_ASYNC_QUEUE_DEPTH,
+                        UBaseType_t priority = 5,
+                        BaseType_t core = 0);
+
+        /// Termine la tâche après les requêtes déjà en file
+        void stop();
+
+        bool running() const { return worker_ != nullptr; }
+
+        esp_err_t submit_read(uint8_t reg, uint8_t *data, size_t len,
+                              AsyncCallback callback, void *ctx = nullptr,
+                              TickType_t wait = 0);
+
+        esp_err_t submit_write(uint8_t reg, const uint8_t *data, size_t len,
+                               AsyncCallback callback, void *ctx = nullptr,
+                               TickType_t wait = 0);
+
+        /// Variante notification : la tâche appelante attend avec ulTaskNotifyTake()
+        esp_err_t submit_read(uint8_t reg, uint8_t *data, size_t len,
+                              esp_err_t *result, TickType_t wait = 0);
+
+        esp_err_t submit_write(uint8_t reg, const uint8_t *data, size_t len,
+                               esp_err_t *result, TickType_t wait = 0);
+
+        esp_err_t submit(const AsyncRequest &req, TickType_t wait = 0);
+
+    private:
+        inline static const char *TAG = "BQ2579X-ASYNC";
+
+        QueueHandle_t queue_ = nullptr;
+        TaskHandle_t worker_ = nullptr;
+
+        static void worker_entry(void *arg);
+        void worker_loop();
+        void complete(const AsyncRequest &req, esp_err_t err);
+    };
+
+} // namespace bq2579x
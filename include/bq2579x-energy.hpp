@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#include "bq2579x-stream.hpp"
+
+namespace bq2579x
+{
+    /// Compteurs cumulés : charge en mA·µs, énergie en nJ (µW·ms), entiers 64 bits
+    struct EnergyCounters
+    {
+        static constexpr int64_t UNITS_PER_UAH = 3600000; // mA·µs par µAh
+        static constexpr int64_t UNITS_PER_UWH = 3600000; // nJ par µWh
+
+        int64_t bat_charge_in = 0;  // IBAT > 0 : charge de la batterie
+        int64_t bat_charge_out = 0; // IBAT < 0 : décharge
+        int64_t bat_energy_in = 0;
+        int64_t bat_energy_out = 0;
+        int64_t input_charge_in = 0; // IBUS > 0 : depuis l'entrée
+        int64_t input_charge_out = 0; // IBUS < 0 : OTG
+        int64_t input_energy_in = 0;
+        int64_t input_energy_out = 0;
+
+        uint32_t gaps = 0;         // intervalles plus longs que max_gap
+        int64_t gap_time_us = 0;   // temps non intégré (au-delà de max_gap)
+
+        int64_t bat_in_uah() const { return bat_charge_in / UNITS_PER_UAH; }
+        int64_t bat_out_uah() const { return bat_charge_out / UNITS_PER_UAH; }
+        int64_t bat_in_uwh() const { return bat_energy_in / UNITS_PER_UWH; }
+        int64_t bat_out_uwh() const { return bat_energy_out / UNITS_PER_UWH; }
+        int64_t input_in_uah() const { return input_charge_in / UNITS_PER_UAH; }
+        int64_t input_in_uwh() const { return input_energy_in / UNITS_PER_UWH; }
+        int64_t bat_net_uah() const { return (bat_charge_in - bat_charge_out) / UNITS_PER_UAH; }
+    };
+
+    /// Persistance injectable (NVS, FRAM...) ; les deux fonctions sont optionnelles
+    struct EnergyStorage
+    {
+        esp_err_t (*load)(EnergyCounters &out, void *ctx) = nullptr;
+        esp_err_t (*save)(const EnergyCounters &counters, void *ctx) = nullptr;
+        void *ctx = nullptr;
+    };
+
+    /**
+     * @class COULOMB_COUNTER
+     * @brief Intégration trapézoïdale de IBAT/VBAT et IBUS/VBUS sur l'horodatage exact des échantillons.
+     *
+     * Les échantillons manqués sont compensés par l'intervalle réel entre deux mesures ;
+     * au-delà de max_gap l'intervalle est borné (pas d'extrapolation ni de débordement)
+     * et compté dans gaps / gap_time_us. Un changement de signe dans l'intervalle est
+     * réparti au point de passage par zéro.
+     */
+    class COULOMB_COUNTER
+    {
+    public:
+        void set_storage(const EnergyStorage &storage);
+
+        /// Recharge les compteurs depuis le stockage (remplace les valeurs courantes)
+        esp_err_t load();
+
+        /// Sauvegarde immédiate
+        esp_err_t save();
+
+        /// Intègre l'échantillon ; marque la sauvegarde due selon save_interval, sans l'effectuer
+        void add(const ADCSample &sample);
+
+        /// Sauvegarde périodique due, à faire hors du chemin d'échantillonnage par save_if_pending()
+        bool save_pending() const;
+        esp_err_t save_if_pending();
+
+        EnergyCounters counters() const;
+        void reset();
+
+        void set_max_gap_us(int64_t us) { max_gap_us_ = us; }
+        void set_save_interval_us(int64_t us) { save_interval_us_ = us; }
+
+    private:
+        struct Point
+        {
+            int64_t t_us = 0;
+            int32_t current_ma = 0;
+            int64_t power_uw = 0;
+            bool valid = false;
+        };
+
+        // Accumulateurs au double de l'unité (aire des trapèzes sans division par 2)
+        struct Accumulator
+        {
+            int64_t residual = 0;
+            void fold(int64_t &counter, int64_t area2, int64_t divisor);
+        };
+
+        mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+        EnergyCounters counters_ = {};
+        EnergyStorage storage_ = {};
+        Point bat_;
+        Point input_;
+        Accumulator acc_[8];
+
+        int64_t max_gap_us_ = static_cast<int64_t>(CONFIG_BQ25798_ENERGY_MAX_GAP_MS) * 1000;
+        int64_t save_interval_us_ = static_cast<int64_t>(CONFIG_BQ25798_ENERGY_SAVE_INTERVAL_S) * 1000000;
+        int64_t last_save_us_ = 0;
+        bool save_pending_ = false;
+
+        /// Retourne le temps non intégré (intervalle au-delà de max_gap)
+        int64_t integrate(Point &prev, const Point &next, size_t acc_base,
+                          int64_t &charge_in, int64_t &charge_out,
+                          int64_t &energy_in, int64_t &energy_out);
+    };
+
+} // namespace bq2579x
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#include "bq2579x-stream.hpp"
+
+namespace bq2579x
+{
+    enum class FilterType : uint8_t
+    {
+        None,
+        MovingAverage, // moyenne des length derniers échantillons
+        Median,        // médiane des length derniers échantillons (length impair)
+        IIR,           // premier ordre : y += (x - y) / 2^shift
+        CIC            // intégrateur-peigne d'ordre order, décimation par length
+    };
+
+    /// Choix du filtre d'une voie
+    struct FilterSpec
+    {
+        static constexpr uint8_t MAX_MEDIAN = 15;
+        static constexpr uint8_t MAX_IIR_SHIFT = 15;
+        static constexpr uint8_t MAX_CIC_ORDER = 4;
+        static constexpr uint8_t CIC_GROWTH_BITS = 14; // order × ⌈log2(decimation)⌉ ≤ 14 : |x| < 2^17 tient sur 32 bits
+
+        FilterType type = FilterType::None;
+        uint8_t length = 0; // fenêtre (moyenne, médiane) ou décimation (CIC)
+        uint8_t shift = 0;  // IIR : coefficient 1 / 2^shift ; CIC : ordre
+
+        static constexpr FilterSpec none() { return {}; }
+        static constexpr FilterSpec moving_average(uint8_t n) { return {FilterType::MovingAverage, n, 0}; }
+        static constexpr FilterSpec median(uint8_t n) { return {FilterType::Median, n, 0}; }
+        static constexpr FilterSpec iir(uint8_t shift) { return {FilterType::IIR, 0, shift}; }
+        static constexpr FilterSpec cic(uint8_t order, uint8_t decimation) { return {FilterType::CIC, decimation, order}; }
+
+        /// Mots d'état pris dans l'arène
+        size_t arena_words() const;
+        bool valid() const;
+    };
+
+    /**
+     * @class ADC_FILTER_BANK
+     * @brief Filtres par voie en virgule fixe entre le décodage ADC et les consommateurs du streaming.
+     *
+     * Les historiques (moyenne, médiane) et les étages CIC occupent une arène statique
+     * de CONFIG_BQ25798_FILTER_ARENA_WORDS mots, répartie à chaque configure() ; les
+     * états sont alors remis à zéro. Un CIC ne produit qu'une valeur toutes les
+     * length entrées : entre deux sorties la voie garde la dernière valeur produite.
+     * Seules les voies valides de l'échantillon avancent leur filtre.
+     */
+    class ADC_FILTER_BANK
+    {
+    public:
+        static constexpr size_t ARENA_WORDS = CONFIG_BQ25798_FILTER_ARENA_WORDS;
+
+        /// Filtres choisis dans Kconfig (IBUS, IBAT), les autres voies sans filtre
+        ADC_FILTER_BANK();
+
+        /// ESP_ERR_INVALID_ARG si le filtre est hors bornes, ESP_ERR_NO_MEM si l'arène est pleine
+        esp_err_t configure(ADCChannel ch, const FilterSpec &spec);
+
+        FilterSpec spec(ADCChannel ch) const;
+
+        /// Filtre l'échantillon en place
+        void apply(ADCSample &sample);
+
+        /// Oublie l'historique de toutes les voies
+        void reset();
+
+        size_t arena_used() const { return arena_used_; }
+
+    private:
+        struct State
+        {
+            uint16_t offset = 0; // premier mot dans l'arène
+            uint8_t index = 0;   // position d'écriture / compteur de décimation
+            uint8_t count = 0;   // historique rempli
+            int64_t acc = 0;     // somme (moyenne) ou y × 2^16 (IIR)
+            int32_t output = 0;  // dernière sortie (CIC)
+            bool primed = false;
+        };
+
+        mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+        FilterSpec specs_[ADC_CHANNEL_COUNT] = {};
+        State states_[ADC_CHANNEL_COUNT] = {};
+        int32_t arena_[ARENA_WORDS] = {};
+        size_t arena_used_ = 0;
+
+        void layout();
+        int32_t step(const FilterSpec &spec, State &st, int32_t x);
+        int32_t median_of(const int32_t *history, uint8_t n) const;
+    };
+
+} // namespace bq2579x
@@ -1,14 +1,42 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 
 #include "esp_err.h"
 #include "esp_log.h"
+#include "sdkconfig.h"
 
 #include "I2CDevices.hpp"
 
+#include "bq2579x-stats.hpp"
+#include "bq2579x-trace.hpp"
+
 namespace bq2579x
 {
+    /// Politique de nouvelle tentative appliquée à chaque transaction I2C
+    struct RetryPolicy
+    {
+        uint8_t max_attempts = CONFIG_BQ25798_I2C_RETRY_ATTEMPTS;       // tentatives par transaction (>= 1)
+        uint32_t backoff_floor_us = CONFIG_BQ25798_I2C_BACKOFF_FLOOR_US; // premier délai, doublé à chaque échec
+        uint32_t backoff_max_us = CONFIG_BQ25798_I2C_BACKOFF_MAX_US;     // plafond du délai
+        uint32_t deadline_us = 0;                                        // durée max d'une transaction, 0 = aucune
+        uint8_t recovery_threshold = CONFIG_BQ25798_I2C_RECOVERY_THRESHOLD; // échecs consécutifs avant récupération, 0 = jamais
+    };
+
+    /// Récupération du bus (9 coups d'horloge SCL, ré-initialisation du maître via I2CDevices, ...)
+    using BusRecoveryHook = esp_err_t (*)(I2CDevices &dev, void *ctx);
+
+    struct BusRecoveryCounters
+    {
+        uint32_t failures = 0;          // transactions échouées (toutes tentatives)
+        uint32_t retries = 0;           // tentatives supplémentaires
+        uint32_t deadline_misses = 0;   // abandons sur échéance
+        uint32_t recoveries = 0;        // récupérations lancées
+        uint32_t recovery_failures = 0; // récupérations en erreur
+        uint32_t recovery_time_us = 0;  // temps cumulé passé en récupération
+    };
+
     /**
      * @class INTERFACE
      * @brief Interface bas-niveau pour accéder aux registres du BQ2579X via I2C.
@@ -18,42 +46,23 @@ namespace bq2579x
     public:
         explicit INTERFACE(I2CDevices &i2c_device) : i2c(i2c_device) {}
 
-        esp_err_t read_register(uint8_t reg, uint8_t *data, size_t len)
-        {
-            esp_err_t err = ESP_FAIL;
-            const int max_attempts = 3;
-
-            for (int attempt = 0; attempt < max_attempts; ++attempt)
-            {
-                err = i2c.read(reg, data, len);
-                if (err == ESP_OK)
-                {
-                    ESP_LOGI(TAG, "I2C READ -> Reg: 0x%02X | Len: %d", reg, static_cast<int>(len));
-                    ESP_LOG_BUFFER_HEX_LEVEL(TAG, data, len, ESP_LOG_INFO);
-                    return ESP_OK;
-                }
-                vTaskDelay(pdMS_TO_TICKS(10));
-            }
-
-            ESP_LOGW(TAG, "Read failed at reg 0x%02X after %d attempts (err=0x%x)", reg, max_attempts, err);
-            return err;
-        }
+        /// deadline_us : échéance de l'appel (0 = celle de la politique)
+        esp_err_t read_register(uint8_t reg, uint8_t *data, size_t len, uint32_t deadline_us = 0);
+        esp_err_t write_register(uint8_t reg, const uint8_t *data, size_t len, uint32_t deadline_us = 0);
 
-        esp_err_t write_register(uint8_t reg, const uint8_t *data, size_t len)
+        void set_retry_policy(const RetryPolicy &policy) { policy_ = policy; }
+        const RetryPolicy &retry_policy() const { return policy_; }
+
+        /// Procédure de récupération partagée par toutes les instances (un seul bus par composant)
+        static void set_bus_recovery(BusRecoveryHook hook, void *ctx = nullptr)
         {
-            esp_err_t err = ESP_FAIL;
-            err = i2c.write(reg, data, len);
-            if (err == ESP_OK)
-            {
-                ESP_LOGI(TAG, "I2C WRITE -> Reg: 0x%02X | Len: %d", reg, static_cast<int>(len));
-                ESP_LOG_BUFFER_HEX_LEVEL(TAG, data, len, ESP_LOG_INFO);
-                return ESP_OK;
-            }
-
-            ESP_LOGW(TAG, "Write failed at reg 0x%02X (err=0x%x)", reg, err);
-            return err;
+            recovery_hook_ = hook;
+            recovery_ctx_ = ctx;
         }
 
+        static BusRecoveryCounters bus_recovery_counters();
+        static void reset_bus_recovery_counters();
+
         esp_err_t read_u8(uint8_t reg, uint8_t &out)
         {
             return read_register(reg, &out, 1);
@@ -73,7 +82,7 @@ namespace bq2579x
             esp_err_t err = read_register(reg, raw, 2);
             if (err != ESP_OK)
                 return err;
-            out = ((raw[0] << 8) | raw[1]);
+            out = to_u16(raw);
             return ESP_OK;
         }
 
@@ -97,11 +106,36 @@ namespace bq2579x
             return write_register(buffer[0], &buffer[1], 2); // i2c_.write(reg, data, len)
         }
 
+        /// Décode un mot 16 bits Big Endian (MSB d'abord) depuis un buffer de lecture en rafale
+        static uint16_t to_u16(const uint8_t *raw)
+        {
+            return static_cast<uint16_t>((raw[0] << 8) | raw[1]);
+        }
+
     protected:
         I2CDevices &i2c;
 
     private:
         inline static const char *TAG = "BQ2579X-INTERFACE";
+
+        RetryPolicy policy_ = {};
+
+        inline static BusRecoveryHook recovery_hook_ = nullptr;
+        inline static void *recovery_ctx_ = nullptr;
+        inline static std::atomic<uint32_t> consecutive_failures_{0};
+
+        inline static std::atomic<uint32_t> failures_{0};
+        inline static std::atomic<uint32_t> retries_{0};
+        inline static std::atomic<uint32_t> deadline_misses_{0};
+        inline static std::atomic<uint32_t> recoveries_{0};
+        inline static std::atomic<uint32_t> recovery_failures_{0};
+        inline static std::atomic<uint32_t> recovery_time_us_{0};
+
+        template <typename Transfer>
+        esp_err_t transfer(Transfer &&op, uint32_t deadline_us, uint8_t &attempts);
+        void on_attempt_failed();
+        void recover_bus();
+        static void backoff_wait(uint32_t delay_us);
     };
 
 } // namespace bq2579x
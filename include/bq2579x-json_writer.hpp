@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace bq2579x
+{
+    /**
+     * @class JsonWriter
+     * @brief Écriture JSON en flux, sans allocation dynamique.
+     *
+     * Le texte est produit soit dans un buffer fourni par l'appelant (terminé par
+     * '\0', tronqué si trop petit), soit vers une fonction d'écriture (UART, socket...).
+     * Le formatage des nombres reproduit std::to_string à l'octet près.
+     */
+    class JsonWriter
+    {
+    public:
+        using Sink = void (*)(const char *data, size_t len, void *ctx);
+
+        JsonWriter(char *buffer, size_t capacity);
+        JsonWriter(Sink sink, void *ctx);
+
+        JsonWriter &raw(const char *text);
+        JsonWriter &raw(const char *text, size_t len);
+        JsonWriter &null();
+
+        // Mêmes surcharges que std::to_string (bool et entiers courts promus en int)
+        JsonWriter &value(int v);
+        JsonWriter &value(long v);
+        JsonWriter &value(long long v);
+        JsonWriter &value(unsigned v);
+        JsonWriter &value(unsigned long v);
+        JsonWriter &value(unsigned long long v);
+        JsonWriter &value(float v);
+        JsonWriter &value(double v);
+
+        /// Octets produits (y compris ceux perdus en cas de troncature)
+        size_t size() const { return written_; }
+        bool overflow() const { return buffer_ != nullptr && written_ >= capacity_; }
+
+        /// Sink écrivant sur stdout
+        static void stdout_sink(const char *data, size_t len, void *ctx);
+
+    private:
+        char *buffer_ = nullptr;
+        size_t capacity_ = 0;
+        Sink sink_ = nullptr;
+        void *ctx_ = nullptr;
+        size_t written_ = 0;
+
+        JsonWriter &unsigned_value(unsigned long long v, bool negative);
+        __attribute__((noinline)) JsonWriter &printf_value(double v);
+    };
+
+    /// Compatibilité : to_json() construit la même sortie dans une std::string
+    template <typename T>
+    std::string to_json_string(const T &obj)
+    {
+        std::string out;
+        JsonWriter w([](const char *data, size_t len, void *ctx)
+                     { static_cast<std::string *>(ctx)->append(data, len); },
+                     &out);
+        obj.write_json(w);
+        return out;
+    }
+
+} // namespace bq2579x
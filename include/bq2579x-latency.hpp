@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bq2579x
+{
+    /// Histogramme de latences : seaux log2 en µs, extrêmes et cumul en ns
+    struct LatencyHistogram
+    {
+        // Seau 0 : < 1 µs ; seau k : [2^(k-1), 2^k) µs ; dernier seau : au-delà
+        static constexpr size_t BUCKETS = 16;
+
+        uint32_t count = 0;
+        uint32_t min_ns = UINT32_MAX;
+        uint32_t max_ns = 0;
+        uint64_t total_ns = 0;
+        uint32_t buckets[BUCKETS] = {};
+
+        void add(uint32_t ns);
+        uint32_t mean_ns() const { return count ? static_cast<uint32_t>(total_ns / count) : 0; }
+
+        /// Borne haute (µs) du seau contenant le centile pct
+        uint32_t percentile_us(uint8_t pct) const;
+    };
+
+    /// Latences de la ligne INT, mesurées au cycle CPU depuis l'ISR
+    struct AlertLatency
+    {
+        LatencyHistogram isr_to_wakeup; // ISR → reprise de la tâche d'alerte
+        LatencyHistogram isr_to_flags;  // ISR → flags lus et décodés dans handle_alert()
+    };
+
+} // namespace bq2579x
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+namespace bq2579x
+{
+    /**
+     * @brief Accès matériel du gestionnaire : ligne INT et compteur de cycles CPU.
+     *
+     * src/port/bq2579x-port_esp.cpp s'appuie sur le pilote GPIO et esp_cpu.
+     * src/port/bq2579x-port_linux.cpp le remplace sur IDF_TARGET=linux : la ligne
+     * INT y est pilotée par le simulateur (simulate_alert()).
+     */
+    namespace port
+    {
+        using AlertHandler = void (*)(void *arg);
+
+        /// Entrée INT avec pull-up, handler appelé en interruption sur front descendant
+        esp_err_t alert_attach(int gpio, AlertHandler handler, void *arg);
+
+        /// Ligne INT au niveau bas
+        bool alert_line_low(int gpio);
+
+        /// Compteur de cycles du cœur courant (utilisable en interruption)
+        uint32_t cycle_count();
+        uint32_t cycles_per_us();
+
+#ifdef CONFIG_IDF_TARGET_LINUX
+        /// Impulsion INT simulée : à passer à BQ25798Sim::set_interrupt_handler()
+        void simulate_alert(void *ctx);
+#endif
+    } // namespace port
+
+} // namespace bq2579x
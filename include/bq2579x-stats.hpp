@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+namespace bq2579x
+{
+    /// Compteurs d'accès d'un registre (les rafales sont comptées sur leur registre de départ)
+    struct RegisterStats
+    {
+        uint32_t reads = 0;
+        uint32_t writes = 0;
+        uint32_t retries = 0;
+        uint32_t failures = 0;
+        uint32_t bytes = 0;
+        uint32_t latency_min_us = UINT32_MAX;
+        uint32_t latency_max_us = 0;
+        uint64_t latency_sum_us = 0;
+
+        uint32_t transactions() const { return reads + writes; }
+        uint32_t latency_avg_us() const
+        {
+            return transactions() ? static_cast<uint32_t>(latency_sum_us / transactions()) : 0;
+        }
+    };
+
+    struct BusStatsSnapshot
+    {
+        static constexpr size_t REG_COUNT = 0x49; // REG00h..REG48h
+        RegisterStats regs[REG_COUNT] = {};
+    };
+
+    /**
+     * @class BUS_STATS
+     * @brief Table statique des accès I2C par adresse de registre.
+     *
+     * Pas d'allocation ; une mise à jour = une courte section critique. Copie et
+     * remise à zéro procèdent registre par registre : les interruptions ne sont
+     * jamais masquées le temps de toute la table (~2,9 Ko).
+     */
+    class BUS_STATS
+    {
+    public:
+        static void record(bool write, uint8_t reg, size_t len, uint8_t attempts, esp_err_t err, uint32_t latency_us)
+        {
+            if (reg >= BusStatsSnapshot::REG_COUNT)
+                return;
+
+            portENTER_CRITICAL(&lock_);
+            RegisterStats &s = table_.regs[reg];
+            if (write)
+                s.writes++;
+            else
+                s.reads++;
+            s.retries += attempts > 1 ? attempts - 1 : 0;
+            if (err != ESP_OK)
+                s.failures++;
+            else
+                s.bytes += len;
+            if (latency_us < s.latency_min_us)
+                s.latency_min_us = latency_us;
+            if (latency_us > s.latency_max_us)
+                s.latency_max_us = latency_us;
+            s.latency_sum_us += latency_us;
+            portEXIT_CRITICAL(&lock_);
+        }
+
+        /// Chaque registre est cohérent ; deux registres peuvent différer d'une transaction
+        static void snapshot(BusStatsSnapshot &out)
+        {
+            for (size_t reg = 0; reg < BusStatsSnapshot::REG_COUNT; ++reg)
+            {
+                portENTER_CRITICAL(&lock_);
+                out.regs[reg] = table_.regs[reg];
+                portEXIT_CRITICAL(&lock_);
+            }
+        }
+
+        static void reset()
+        {
+            for (size_t reg = 0; reg < BusStatsSnapshot::REG_COUNT; ++reg)
+            {
+                portENTER_CRITICAL(&lock_);
+                table_.regs[reg] = {};
+                portEXIT_CRITICAL(&lock_);
+            }
+        }
+
+    private:
+        inline static BusStatsSnapshot table_ = {};
+        inline static portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+    };
+
+} // namespace bq2579x
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ctrl/bq2579x-adc_channel.hpp"
+
+namespace bq2579x
+{
+    /// Mesure horodatée en virgule fixe : mA, mV, TS en millièmes de %, TDIE en dixièmes de °C
+    struct ADCSample
+    {
+        uint32_t sequence = 0;
+        int64_t timestamp_us = 0;
+        int32_t value[ADC_CHANNEL_COUNT] = {};
+        uint16_t valid = 0; // voies lues (adc_channel_bit), les autres valent 0
+
+        int32_t get(ADCChannel ch) const { return value[static_cast<size_t>(ch)]; }
+        bool is_valid(ADCChannel ch) const { return valid & adc_channel_bit(ch); }
+    };
+
+    /// Position de lecture propre à chaque consommateur
+    struct SampleCursor
+    {
+        uint32_t next = 0;     // séquence du prochain échantillon attendu
+        uint32_t overruns = 0; // échantillons écrasés avant d'avoir été lus
+    };
+
+    /**
+     * @class SampleRing
+     * @brief Anneau un producteur / plusieurs consommateurs, sans verrou.
+     *
+     * Chaque case est protégée par un compteur de séquence (seqlock) : impair
+     * pendant l'écriture, 2 * (séquence + 1) une fois publiée. Un lecteur qui
+     * observe une case réécrite pendant sa copie recommence ; le producteur ne
+     * bloque jamais et un consommateur lent perd les plus anciens échantillons.
+     */
+    template <size_t N>
+    class SampleRing
+    {
+        static_assert(N >= 2, "ring needs at least two slots");
+
+    public:
+        /// Côté producteur (une seule tâche)
+        void push(const ADCSample &sample)
+        {
+            const uint32_t seq = head_.load(std::memory_order_relaxed);
+            Slot &slot = slots_[seq % N];
+            slot.version.store(2 * seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(&slot.sample, &sample, sizeof(ADCSample));
+            slot.sample.sequence = seq;
+            slot.version.store(2 * seq + 2, std::memory_order_release);
+            head_.store(seq + 1, std::memory_order_release);
+        }
+
+        /// Curseur positionné après le dernier échantillon publié
+        SampleCursor cursor() const
+        {
+            SampleCursor c;
+            c.next = head_.load(std::memory_order_acquire);
+            return c;
+        }
+
+        /// Copie le prochain échantillon du curseur ; false si aucun nouveau
+        bool read(SampleCursor &c, ADCSample &out) const
+        {
+            while (true)
+            {
+                const uint32_t head = head_.load(std::memory_order_acquire);
+                if (c.next == head)
+                    return false;
+                if (head - c.next > N)
+                {
+                    c.overruns += head - c.next - N;
+                    c.next = head - N;
+                }
+
+                const Slot &slot = slots_[c.next % N];
+                const uint32_t expected = 2 * c.next + 2;
+                if (slot.version.load(std::memory_order_acquire) != expected)
+                {
+                    // Case déjà réutilisée : le lecteur a été doublé
+                    c.overruns++;
+                    c.next++;
+                    continue;
+                }
+                std::memcpy(&out, &slot.sample, sizeof(ADCSample));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.version.load(std::memory_order_relaxed) != expected)
+                {
+                    c.overruns++;
+                    c.next++;
+                    continue;
+                }
+                c.next++;
+                return true;
+            }
+        }
+
+        /// Dernier échantillon publié
+        bool latest(ADCSample &out) const
+        {
+            SampleCursor c;
+            c.next = head_.load(std::memory_order_acquire) - 1;
+            if (c.next == UINT32_MAX)
+                return false;
+            return read(c, out);
+        }
+
+        uint32_t published() const { return head_.load(std::memory_order_acquire); }
+
+        static constexpr size_t capacity() { return N; }
+
+    private:
+        struct Slot
+        {
+            std::atomic<uint32_t> version{0};
+            ADCSample sample;
+        };
+
+        Slot slots_[N];
+        std::atomic<uint32_t> head_{0};
+    };
+
+    /// Compteurs de l'échantillonnage périodique
+    struct StreamStats
+    {
+        uint32_t samples = 0;
+        uint32_t read_errors = 0;
+        uint32_t late_periods = 0;  // lecture plus longue que la période
+        uint32_t last_read_us = 0;
+        uint32_t max_read_us = 0;
+    };
+
+} // namespace bq2579x
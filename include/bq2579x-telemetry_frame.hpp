@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ctrl/bq2579x-adc_snapshot.hpp"
+
+// Sans dépendance ESP-IDF (avec ctrl/bq2579x-adc_snapshot.hpp) : utilisable tel quel
+// côté serveur pour décoder les trames reçues.
+
+namespace bq2579x
+{
+    /**
+     * @class TelemetryFrame
+     * @brief Trame binaire versionnée (petit-boutiste) : mesures ADC, statuts et horodatage.
+     *
+     * Disposition v2 (47 octets) :
+     *   [0]      magic (0xB7)
+     *   [1]      version
+     *   [2..3]   numéro de séquence
+     *   [4..11]  horodatage (µs depuis le démarrage)
+     *   [12..13] ICO (REG19h, brut)
+     *   [14..35] ADC bruts REG31h..REG45h, dans l'ordre des registres
+     *   [36..37] voies ADC valides (bit i = adc_raw[i] lu, sinon 0)
+     *   [38..44] statuts REG1Bh..REG21h
+     *   [45..46] CRC-16/CCITT-FALSE des octets [0..44]
+     *
+     * Les valeurs sont transmises brutes ; les accesseurs appliquent les conversions
+     * communes de bq2579x-adc_snapshot.hpp.
+     */
+    struct TelemetryFrame
+    {
+        static constexpr uint8_t MAGIC = 0xB7;
+        static constexpr uint8_t VERSION = 2;
+        static constexpr size_t ADC_COUNT = 11;
+        static constexpr size_t STATUS_COUNT = 7;
+        static constexpr size_t SIZE = 4 + 8 + 2 + ADC_COUNT * 2 + 2 + STATUS_COUNT + 2;
+
+        enum ADCIndex : uint8_t
+        {
+            IBUS,
+            IBAT,
+            VBUS,
+            VAC1,
+            VAC2,
+            VBAT,
+            VSYS,
+            TS,
+            TDIE,
+            DPLUS,
+            DMINUS
+        };
+
+        enum class DecodeResult
+        {
+            Ok,
+            TooShort,
+            BadMagic,
+            BadVersion,
+            BadCrc
+        };
+
+        uint16_t sequence = 0;
+        uint64_t timestamp_us = 0;
+        uint16_t ico_raw = 0;
+        uint16_t adc_raw[ADC_COUNT] = {};
+        uint16_t adc_valid = 0;
+        uint8_t status[STATUS_COUNT] = {};
+
+        // === Conversions (bq2579x-adc_snapshot.hpp) ===
+        bool is_valid(ADCIndex ch) const { return adc_valid & (1u << ch); }
+
+        uint16_t ico_current_ma() const { return (ico_raw & 0x01FF) * 10; }
+        uint16_t ibus_ma() const { return adc_ibus_ma(adc_raw[IBUS]); }
+        int16_t ibat_ma() const { return adc_ibat_ma(adc_raw[IBAT]); }
+        uint16_t vbus_mv() const { return adc_mv(adc_raw[VBUS]); }
+        uint16_t vac1_mv() const { return adc_mv(adc_raw[VAC1]); }
+        uint16_t vac2_mv() const { return adc_mv(adc_raw[VAC2]); }
+        uint16_t vbat_mv() const { return adc_mv(adc_raw[VBAT]); }
+        uint16_t vsys_mv() const { return adc_mv(adc_raw[VSYS]); }
+        uint32_t ts_milli_pct() const { return adc_ts_milli_pct(adc_raw[TS]); }
+        int16_t tdie_dc() const { return adc_tdie_dc(adc_raw[TDIE]); }
+        uint16_t dplus_mv() const { return adc_mv(adc_raw[DPLUS]); }
+        uint16_t dminus_mv() const { return adc_mv(adc_raw[DMINUS]); }
+
+        /// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+        static uint16_t crc16(const uint8_t *data, size_t len)
+        {
+            uint16_t crc = 0xFFFF;
+            for (size_t i = 0; i < len; ++i)
+            {
+                crc ^= static_cast<uint16_t>(data[i]) << 8;
+                for (int bit = 0; bit < 8; ++bit)
+                    crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+            }
+            return crc;
+        }
+
+        /// Sérialise la trame ; retourne SIZE, ou 0 si le buffer est trop petit
+        size_t encode(uint8_t *out, size_t capacity) const
+        {
+            if (out == nullptr || capacity < SIZE)
+                return 0;
+
+            size_t pos = 0;
+            out[pos++] = MAGIC;
+            out[pos++] = VERSION;
+            put_u16(out, pos, sequence);
+            for (int i = 0; i < 8; ++i)
+                out[pos++] = static_cast<uint8_t>(timestamp_us >> (8 * i));
+            put_u16(out, pos, ico_raw);
+            for (size_t i = 0; i < ADC_COUNT; ++i)
+                put_u16(out, pos, adc_raw[i]);
+            put_u16(out, pos, adc_valid);
+            for (size_t i = 0; i < STATUS_COUNT; ++i)
+                out[pos++] = status[i];
+            put_u16(out, pos, crc16(out, pos));
+            return pos;
+        }
+
+        /// Désérialise et vérifie une trame (magic, version, CRC)
+        static DecodeResult decode(const uint8_t *in, size_t len, TelemetryFrame &frame)
+        {
+            if (in == nullptr || len < SIZE)
+                return DecodeResult::TooShort;
+            if (in[0] != MAGIC)
+                return DecodeResult::BadMagic;
+            if (in[1] != VERSION)
+                return DecodeResult::BadVersion;
+
+            size_t pos = SIZE - 2;
+            if (get_u16(in, pos) != crc16(in, SIZE - 2))
+                return DecodeResult::BadCrc;
+
+            pos = 2;
+            frame.sequence = get_u16(in, pos);
+            frame.timestamp_us = 0;
+            for (int i = 0; i < 8; ++i)
+                frame.timestamp_us |= static_cast<uint64_t>(in[pos++]) << (8 * i);
+            frame.ico_raw = get_u16(in, pos);
+            for (size_t i = 0; i < ADC_COUNT; ++i)
+                frame.adc_raw[i] = get_u16(in, pos);
+            frame.adc_valid = get_u16(in, pos);
+            for (size_t i = 0; i < STATUS_COUNT; ++i)
+                frame.status[i] = in[pos++];
+            return DecodeResult::Ok;
+        }
+
+    private:
+        static void put_u16(uint8_t *out, size_t &pos, uint16_t v)
+        {
+            out[pos++] = static_cast<uint8_t>(v);
+            out[pos++] = static_cast<uint8_t>(v >> 8);
+        }
+
+        static uint16_t get_u16(const uint8_t *in, size_t &pos)
+        {
+            uint16_t v = static_cast<uint16_t>(in[pos] | (in[pos + 1] << 8));
+            pos += 2;
+            return v;
+        }
+    };
+
+    static_assert(TelemetryFrame::SIZE == 47, "telemetry frame v2 layout changed");
+    static_assert(TelemetryFrame::ADC_COUNT == ADC_CHANNEL_COUNT && TelemetryFrame::DMINUS == static_cast<size_t>(ADCChannel::DMINUS),
+                  "telemetry frame ADC order must follow ADCChannel");
+
+} // namespace bq2579x
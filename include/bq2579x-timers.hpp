@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bq2579x
+{
+    /**
+     * @class TIMER_WHEEL
+     * @brief Échéances de la boucle du gestionnaire, une case par traitement périodique.
+     *
+     * Quelques échéances seulement : un tableau parcouru en entier tient lieu de roue.
+     * Une case échue est désarmée par fire() ; son traitement la réarme avec
+     * advance() (période sans dérive) ou arm(). Utilisé depuis une seule tâche.
+     */
+    class TIMER_WHEEL
+    {
+    public:
+        static constexpr size_t MAX_TIMERS = 8;
+        static constexpr int64_t NEVER = INT64_MAX;
+
+        /// Échéance absolue (esp_timer_get_time), remplace la précédente
+        void arm(size_t slot, int64_t deadline_us);
+        void cancel(size_t slot);
+        bool armed(size_t slot) const;
+
+        /// Réarme une case échue une période après sa dernière échéance ; rattrape now si en retard (retourne false)
+        bool advance(size_t slot, uint32_t period_us, int64_t now_us);
+
+        /// Plus proche échéance, NEVER si aucune case armée
+        int64_t next_deadline_us() const;
+
+        /// Cases échues à now (bit i = case i), désarmées
+        uint32_t fire(int64_t now_us);
+
+    private:
+        int64_t deadline_us_[MAX_TIMERS] = {NEVER, NEVER, NEVER, NEVER, NEVER, NEVER, NEVER, NEVER};
+        int64_t fired_us_[MAX_TIMERS] = {};
+    };
+
+} // namespace bq2579x
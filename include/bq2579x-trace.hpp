@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#ifdef CONFIG_BQ25798_TRACE
+#include "esp_timer.h"
+#endif
+
+namespace bq2579x
+{
+    enum class TraceDirection : uint8_t
+    {
+        Read,
+        Write
+    };
+
+    struct TraceEntry
+    {
+        uint32_t timestamp_us = 0; // esp_timer tronqué à 32 bits
+        esp_err_t err = ESP_OK;
+        uint8_t reg = 0;
+        uint8_t len = 0;
+        TraceDirection dir = TraceDirection::Read;
+    };
+
+#ifdef CONFIG_BQ25798_TRACE
+    /**
+     * @class TRACE
+     * @brief Journal circulaire des transactions I2C, en mémoire et de taille fixe.
+     *
+     * L'enregistrement ne coûte qu'un incrément atomique et quelques stores ;
+     * le contenu n'est formaté que sur demande (dump()).
+     */
+    class TRACE
+    {
+    public:
+        static constexpr size_t DEPTH = CONFIG_BQ25798_TRACE_DEPTH;
+
+        static inline void record(TraceDirection dir, uint8_t reg, size_t len, esp_err_t err)
+        {
+            const uint32_t index = head_.fetch_add(1, std::memory_order_relaxed);
+            TraceEntry &entry = ring_[index % DEPTH];
+            entry.timestamp_us = static_cast<uint32_t>(esp_timer_get_time());
+            entry.err = err;
+            entry.reg = reg;
+            entry.len = static_cast<uint8_t>(len);
+            entry.dir = dir;
+        }
+
+        /// Copie les entrées de la plus ancienne à la plus récente, retourne le nombre copié
+        static size_t snapshot(TraceEntry *out, size_t max_entries);
+
+        /// Affiche le contenu du journal sur la console
+        static void dump();
+
+        static void clear();
+
+    private:
+        inline static const char *TAG = "BQ2579X-TRACE";
+        inline static TraceEntry ring_[DEPTH] = {};
+        inline static std::atomic<uint32_t> head_{0};
+    };
+
+#define BQ2579X_TRACE(dir, reg, len, err) ::bq2579x::TRACE::record((dir), (reg), (len), (err))
+#else
+#define BQ2579X_TRACE(dir, reg, len, err) \
+    do                                    \
+    {                                     \
+    } while (0)
+#endif
+
+} // namespace bq2579x
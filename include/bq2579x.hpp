@@ -1,17 +1,32 @@
 #pragma once
 
+#include <atomic>
+
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "sdkconfig.h"
 
-#include "driver/gpio.h"
+#include "esp_attr.h"
 #include "esp_log.h"
-#include "esp_intr_alloc.h"
 
 #include "ctrl/bq2579x-ctrl.hpp"
 #include "config/bq2579x-config.hpp"
 #include "status/bq2579x-status.hpp"
+#include "status/bq2579x-events.hpp"
+#include "bq2579x-async.hpp"
+#include "bq2579x-telemetry_frame.hpp"
+#include "bq2579x-stream.hpp"
+#include "bq2579x-adc_rate_groups.hpp"
+#include "bq2579x-alert_guard.hpp"
+#include "bq2579x-timers.hpp"
+#include "bq2579x-adc_scheduler.hpp"
+#include "bq2579x-adc_stats.hpp"
+#include "bq2579x-energy.hpp"
+#include "bq2579x-filter.hpp"
+#include "bq2579x-latency.hpp"
+#include "bq2579x-port.hpp"
 
 namespace bq2579x
 {
@@ -19,9 +34,15 @@ namespace bq2579x
     {
         None,
         Log,
-        JSON
+        JSON,
+        Binary
     };
 
+    using StreamRing = SampleRing<CONFIG_BQ25798_STREAM_DEPTH>;
+
+    /// Reçoit chaque trame OutputFormat::Binary (TelemetryFrame::SIZE octets)
+    using TelemetrySink = void (*)(const uint8_t *frame, size_t len, void *ctx);
+
     class BQ2579XManager
     {
     public:
@@ -44,29 +65,229 @@ namespace bq2579x
         /// Gère une alerte si déclenchée par le GPIO
         esp_err_t handle_alert();
 
+        /// Abonnements aux événements décodés de chaque alerte (rappel ou file)
+        EVENT_DISPATCHER &events() { return events_; }
+
+        /// Latences ISR → réveil de la tâche et ISR → flags décodés (CONFIG_BQ25798_ALERT_LATENCY)
+        AlertLatency get_alert_latency() const;
+        void reset_alert_latency();
+
+        /// Protection contre les rafales d'alertes (CONFIG_BQ25798_ALERT_STORM_GUARD) ; masquage au-delà de threshold
+        /// alertes par seconde, à garder sous 1000 / min_interval_ms ; 0 : jamais de masquage
+        void set_storm_protection(uint32_t min_interval_ms, uint16_t threshold, uint32_t backoff_ms);
+        StormStats get_storm_stats() const;
+
+        /// Dernier contrôle périodique du composant réussi (CONFIG_BQ25798_HEALTH_PERIOD_MS)
+        bool healthy() const { return healthy_.load(); }
+
         /// Récupère les mesures courantes
         esp_err_t get_measurements(OutputFormat format = OutputFormat::None);
 
         /// Optionnel : affichage état alertes/config
         esp_err_t get_status(OutputFormat format = OutputFormat::None);
 
+        /// Remplace la table mode ADC / état de charge (copiée)
+        esp_err_t set_adc_policy(const ADCPolicyRule *rules, size_t count, const ADCSchedule &fallback);
+
+        /// Adapte le mode ADC à l'état du chargeur à chaque alerte (CONFIG_BQ25798_ADC_ADAPTIVE)
+        esp_err_t set_adaptive_adc(bool enable);
+
+        /// Mode ADC en vigueur ; period_ms est la période d'acquisition conseillée
+        ADCSchedule current_adc_schedule() const;
+
+        /// Statistiques par voie alimentées par get_measurements() et le streaming (CONFIG_BQ25798_ADC_STATS)
+        ADC_STATS &adc_stats() { return adc_stats_; }
+
+        /// Compteur coulométrique batterie / entrée (CONFIG_BQ25798_ENERGY) ; persistance via set_storage()
+        COULOMB_COUNTER &energy() { return energy_; }
+
+        /// Filtres par voie appliqués aux échantillons du streaming (CONFIG_BQ25798_FILTER)
+        ADC_FILTER_BANK &filters() { return filters_; }
+
+        /// Cadence propre par groupe de voies pour le streaming (CONFIG_BQ25798_RATE_GROUPS,
+        /// sinon ESP_ERR_NOT_SUPPORTED)
+        esp_err_t set_adc_rate_groups(const ADCRateGroup *groups, size_t count);
+
+        /// Lance l'échantillonnage périodique de l'ADC (conversion continue) vers stream()
+        esp_err_t start_streaming(uint32_t period_ms = CONFIG_BQ25798_STREAM_PERIOD_MS);
+
+        /// Arrête l'échantillonnage et restaure le mode ADC configuré
+        void stop_streaming();
+
+        bool streaming() const { return stream_active_.load(); }
+
+        /// Échantillons horodatés : chaque consommateur lit avec son propre SampleCursor
+        const StreamRing &stream() const { return stream_ring_; }
+
+        StreamStats get_stream_stats() const;
+
+        /// Destination des trames binaires (radio, UART...)
+        void set_telemetry_sink(TelemetrySink sink, void *ctx = nullptr);
+
+        /// Construit une trame à partir des dernières mesures et statuts lus, datée de la lecture ADC ;
+        /// with_adc = false : voies ADC marquées invalides, datée de l'appel
+        void build_telemetry_frame(TelemetryFrame &frame, bool with_adc = true);
+
+        /// Affiche le journal des transactions I2C (CONFIG_BQ25798_TRACE)
+        void dump_trace() const;
+
+        /// Accès registres non bloquant (tâche du bus démarrée par init())
+        ASYNC_INTERFACE &async() { return async_; }
+
+        /// Applique la politique de nouvelle tentative à tous les accès du composant
+        void set_retry_policy(const RetryPolicy &policy);
+
+        /// Procédure appelée après recovery_threshold échecs consécutifs
+        void set_bus_recovery(BusRecoveryHook hook, void *ctx = nullptr);
+
+        BusRecoveryCounters get_bus_recovery_counters() const;
+        void reset_bus_recovery_counters();
+
+        /// Copie les compteurs d'accès par registre (CONFIG_BQ25798_BUS_STATS)
+        esp_err_t get_bus_stats(BusStatsSnapshot &out) const;
+        void reset_bus_stats();
+
 
     private:
         I2CDevices &i2c_;
         Config cfg_;
-        gpio_num_t alert_gpio_;
+        int alert_gpio_;
         STATUS status_;
         CTRL ctrl_;
+        ASYNC_INTERFACE async_;
+        EVENT_DISPATCHER events_;
 
         inline static const char *TAG = "BQ2579X_MANAGER";
-        bool ready_ = false;
+        static constexpr uint32_t ADC_TIMEOUT_MARGIN_US = 10000;
+        std::atomic<bool> ready_{false};
         esp_err_t is_ready();
 
+        // Configuration (cfg_), statuts décodés (status_), ordonnancement ADC et masques de la
+        // protection : partagés entre la boucle et les tâches appelantes, modifiés sous ce verrou.
+        // Récursif : apply_config() est rappelée depuis handle_alert() et health_check().
+        // Jamais tenu pendant une attente de la boucle ni pendant la diffusion des événements.
+        StaticSemaphore_t state_lock_buf_;
+        SemaphoreHandle_t state_lock_ = nullptr;
+        struct StateLock
+        {
+            explicit StateLock(const BQ2579XManager &m) : lock_(m.state_lock_)
+            {
+                xSemaphoreTakeRecursive(lock_, portMAX_DELAY);
+            }
+            ~StateLock() { xSemaphoreGiveRecursive(lock_); }
+            StateLock(const StateLock &) = delete;
+            StateLock &operator=(const StateLock &) = delete;
+            SemaphoreHandle_t lock_;
+        };
+
         TaskHandle_t task_handle_ = nullptr;
 
+        // Streaming : CTRL dédié pour ne pas partager les registres décodés avec get_measurements()
+        CTRL stream_ctrl_;
+        StreamRing stream_ring_;
+        std::atomic<bool> stream_active_{false};
+        int64_t stream_due_us_ = 0;    // début de la période en cours (tâche du gestionnaire)
+        int64_t stream_sample_us_ = 0; // horodatage de l'échantillon en cours
+        bool stream_converting_ = false;
+        std::atomic<uint32_t> stream_period_ms_{0};
+        std::atomic<uint32_t> stream_oneshot_us_{0}; // 0 : conversion continue
+        std::atomic<uint16_t> stream_adc_channels_{ADC_ALL_CHANNELS};
+        uint8_t stream_saved_adc_control_ = 0;
+        StreamStats stream_stats_ = {};
+        mutable portMUX_TYPE stream_stats_lock_ = portMUX_INITIALIZER_UNLOCKED;
+        void stream_step();
+
+        ADC_STATS adc_stats_;
+        COULOMB_COUNTER energy_;
+        ADC_FILTER_BANK filters_;
+        ADC_RATE_GROUPS rate_groups_;
+
+        // Ordonnancement ADC selon l'état de charge
+        ADC_SCHEDULER adc_scheduler_;
+        bool adaptive_adc_ = false;
+        bool adc_schedule_applied_ = false;
+        ADCSchedule adc_schedule_ = {};
+        esp_err_t apply_adc_schedule(bool force);
+
+        TelemetrySink telemetry_sink_ = nullptr;
+        void *telemetry_ctx_ = nullptr;
+        uint16_t telemetry_sequence_ = 0;
+        esp_err_t emit_telemetry(bool with_adc);
+
+        // Mesure de latence de la ligne INT (cycles CPU de l'ISR)
+        AlertLatency alert_latency_ = {};
+        mutable portMUX_TYPE alert_latency_lock_ = portMUX_INITIALIZER_UNLOCKED;
+        std::atomic<uint32_t> alert_isr_stamp_{0}; // écrit par l'ISR, 0 : aucun
+        uint32_t alert_isr_cycles_ = 0;
+        bool alert_isr_pending_ = false;
+        void record_alert_latency(LatencyHistogram &hist, uint32_t isr_cycles);
+
+        // Rafales d'alertes : masquage temporaire des sources trop fréquentes
+        ALERT_GUARD alert_guard_;
+        uint64_t storm_masked_ = 0; // bits de masque posés par la protection (event_bit)
+        esp_err_t set_event_masks(uint64_t events, bool masked);
+        size_t flags_span_ = STATUS::FLAGS_BLOCK_LEN; // fenêtre des masques écrits dans le composant
+        static size_t flags_span(const ConfigMask &m);
+        size_t alert_flags_span();
+        esp_err_t discard_unread_flags(size_t span);
+        void service_storm_unmask();
+
+        // Boucle de la tâche : notification INT, demandes des autres tâches et échéances
+        enum LoopTimer : size_t
+        {
+            TIMER_STREAM,
+            TIMER_ALERT,  // alerte différée par l'intervalle minimal de service
+            TIMER_UNMASK,
+            TIMER_WATCHDOG,
+            TIMER_HEALTH,
+            TIMER_SAVE // sauvegarde des compteurs d'énergie demandée par le streaming
+        };
+        enum LoopRequest : uint32_t
+        {
+            REQUEST_STREAM_START = 1 << 0,
+            REQUEST_STREAM_STOP = 1 << 1,
+            REQUEST_ADC_PLAN = 1 << 2 // voies de stream_ctrl_ : stream_adc_channels_
+        };
+        TIMER_WHEEL timers_;
+        std::atomic<bool> alert_pending_{false};
+        std::atomic<uint32_t> loop_requests_{0};
+        // Acquittement des demandes bloquantes : sémaphore propre, pas la notification de l'appelant
+        StaticSemaphore_t loop_ack_buf_;
+        SemaphoreHandle_t loop_ack_ = nullptr;
+        std::atomic<bool> loop_ack_wanted_{false};
+        // Sérialise start_streaming() / stop_streaming() entre tâches
+        StaticSemaphore_t stream_control_lock_buf_;
+        SemaphoreHandle_t stream_control_lock_ = nullptr;
+        struct StreamControlLock
+        {
+            explicit StreamControlLock(BQ2579XManager &m)
+                : m_(m), held_(xTaskGetCurrentTaskHandle() != m.task_handle_)
+            {
+                // La boucle n'attend jamais ce verrou : son détenteur peut attendre la boucle
+                if (held_)
+                    xSemaphoreTake(m_.stream_control_lock_, portMAX_DELAY);
+            }
+            ~StreamControlLock()
+            {
+                if (held_)
+                    xSemaphoreGive(m_.stream_control_lock_);
+            }
+            BQ2579XManager &m_;
+            const bool held_;
+        };
+        bool alert_deferred_ = false;
+        std::atomic<bool> healthy_{true};
+        void post_loop_request(uint32_t request, bool wait);
+        void run_loop_requests();
+        void on_alert(uint32_t isr_cycles);
+        void service_alert();
+        esp_err_t read_alert(ChargerEventMessage &msg);
+        void health_check();
+        TickType_t loop_wait_ticks() const;
+
         static void task_wrapper(void *arg);
         static void IRAM_ATTR gpio_isr_handler(void *arg);
-        void setup_interrupt(gpio_num_t gpio);
+        void setup_interrupt(int gpio);
         void task_main();
     };
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bitset>
 #include <cstdint>
 #include <string>
 
@@ -152,14 +153,39 @@ namespace bq2579x
         esp_err_t set_adc_registers();
 
         esp_err_t get();
+
+        /// N'écrit que les registres qui diffèrent de l'image connue du composant
         esp_err_t set();
 
+        /// Oublie l'image connue (reset registres, expiration watchdog) : le prochain set() réécrit tout
+        void invalidate_cache();
+
+        /// Force la réécriture d'un registre au prochain set()
+        void mark_dirty(uint8_t reg);
+
         ConfigParams &datas() { return params_; };
         const ConfigParams &datas() const { return params_; };
 
+        static constexpr size_t REG_COUNT = 0x49; // REG00h..REG48h
+
     private:
         ConfigParams params_;
         inline static const char *TAG = "BQ2579X_CONFIG";
+
+        using RegisterSet = std::bitset<REG_COUNT>;
+
+        // Image du composant telle que connue après la dernière lecture/écriture réussie
+        uint8_t shadow_[REG_COUNT] = {};
+        RegisterSet known_;
+        RegisterSet dirty_;
+
+        void build_image(uint8_t *image, RegisterSet &present, RegisterSet &word_lsb) const;
+        void cache_store(uint8_t reg, const uint8_t *data, size_t len);
+
+        esp_err_t load_u8(uint8_t reg, uint8_t &out);
+        esp_err_t load_u16(uint8_t reg, uint16_t &out);
+        esp_err_t store_u8(uint8_t reg, uint8_t value);
+        esp_err_t store_u16(uint8_t reg, uint16_t value);
     };
 
 } // namespace bq2579x
@@ -3,6 +3,9 @@
 #include <cstdint>
 #include <string>
 
+#include "bq2579x-json_writer.hpp"
+#include "ctrl/bq2579x-adc_channel.hpp"
+
 namespace bq2579x
 {
     // REG2Eh - ADC Control
@@ -36,6 +39,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ADCControlRegister";
@@ -67,6 +71,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ADCFunctionDisable0Register";
@@ -95,6 +100,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ADCFunctionDisable1Register";
@@ -108,6 +114,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
     };
 
     struct ConfigADC
@@ -115,7 +122,21 @@ namespace bq2579x
         ADCControlRegister acd = {};
         ADCFunctionDisableRegister adc_function_disable = {};
 
+        /// Durée de conversion d'une voie selon ADC_SAMPLE (15, 14, 13, 12 bits : 24, 12, 6, 3 ms)
+        static constexpr uint32_t channel_conversion_time_us(ADCControlRegister::ADCSampleResolution res)
+        {
+            return 24000u >> static_cast<uint8_t>(res);
+        }
+
+        /// Voies non désactivées dans REG2Fh/REG30h (masque adc_channel_bit)
+        uint16_t enabled_channels() const;
+        uint8_t enabled_channel_count() const;
+
+        /// Durée d'une conversion de toutes les voies actives
+        uint32_t conversion_time_us() const;
+
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
     };
 }
\ No newline at end of file
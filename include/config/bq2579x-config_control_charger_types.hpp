@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "bq2579x-json_writer.hpp"
+
 namespace bq2579x
 {
     // REG0Fh - Charger Control 0
@@ -31,6 +33,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerControl0Register";
@@ -87,6 +90,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerControl1Register";
@@ -126,6 +130,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerControl2Register";
@@ -158,6 +163,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerControl3Register";
@@ -190,6 +196,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerControl4Register";
@@ -228,6 +235,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerControl5Register";
@@ -245,5 +253,6 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
     };
 }
\ No newline at end of file
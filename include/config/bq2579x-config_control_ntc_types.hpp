@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "bq2579x-json_writer.hpp"
+
 namespace bq2579x
 {
     // REG17h - NTC Control 0
@@ -46,6 +48,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_NTCControl0Register";
@@ -105,6 +108,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_NTCControl1Register";
@@ -118,5 +122,6 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
     };
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "bq2579x-json_writer.hpp"
+
 #include "config/bq2579x-config_control_charger_types.hpp"
 #include "config/bq2579x-config_control_ntc_types.hpp"
 
@@ -37,6 +39,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_PrechargeControlRegister";
@@ -64,6 +67,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_TerminationControlRegister";
@@ -107,6 +111,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_RechargeControlRegister";
@@ -153,6 +158,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_TimerControlRegister";
@@ -209,6 +215,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_MPPTControlRegister";
@@ -255,6 +262,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_TemperatureControlRegister";
@@ -293,6 +301,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_DPDMDriverRegister";
@@ -313,5 +322,6 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
     };
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "bq2579x-json_writer.hpp"
+
 namespace bq2579x
 {
     // REG00h - Minimal System Voltage (VSYSMIN)
@@ -135,6 +137,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
     };
 
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "bq2579x-json_writer.hpp"
+
 namespace bq2579x
 {
     // REG28h - Charger Mask 0
@@ -31,6 +33,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerMask0Register";
@@ -61,6 +64,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerMask1Register";
@@ -92,6 +96,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerMask2Register";
@@ -121,6 +126,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerMask3Register";
@@ -153,6 +159,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_FaultMask0Register";
@@ -182,6 +189,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_FaultMask1Register";
@@ -198,6 +206,7 @@ namespace bq2579x
         void log() const;
 
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
     };
 
     struct FaultMaskRegister
@@ -208,6 +217,7 @@ namespace bq2579x
         void log() const;
 
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
     };
 
     struct ConfigMask
@@ -218,5 +228,6 @@ namespace bq2579x
         void log() const;
 
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
     };
 }
\ No newline at end of file
@@ -22,14 +22,22 @@ namespace bq2579x
             adc.log();
         }
 
+        void write_json(JsonWriter &w) const
+        {
+            w.raw("{\"limit\": ");
+            limit.write_json(w);
+            w.raw(",\"control\": ");
+            control.write_json(w);
+            w.raw(",\"mask\": ");
+            mask.write_json(w);
+            w.raw(",\"adc\": ");
+            adc.write_json(w);
+            w.raw("}");
+        }
+
         std::string to_json() const
         {
-            return std::string("{") +
-                   "\"limit\": " + limit.to_json() + "," +
-                   "\"control\": " + control.to_json() + "," +
-                   "\"mask\": " + mask.to_json() + "," +
-                   "\"adc\": " + adc.to_json() +
-                   "}";
+            return to_json_string(*this);
         }
     };
 }
\ No newline at end of file
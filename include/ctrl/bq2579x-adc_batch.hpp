@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ctrl/bq2579x-adc_snapshot.hpp"
+
+// Conversions par lots pour le post-traitement (hôte ou cible) : mêmes formules que
+// les registres CTRL, boucles sans branche ni alias pour la vectorisation automatique.
+
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define BQ2579X_RESTRICT __restrict
+#else
+#define BQ2579X_RESTRICT
+#endif
+
+namespace bq2579x
+{
+    inline void adc_ibat_ma_batch(const uint16_t *BQ2579X_RESTRICT raw, int32_t *BQ2579X_RESTRICT out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = adc_ibat_ma(raw[i]);
+    }
+
+    /// IBUS et tensions (LSB 1 mA / 1 mV) : simple élargissement
+    inline void adc_unsigned_batch(const uint16_t *BQ2579X_RESTRICT raw, int32_t *BQ2579X_RESTRICT out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = adc_mv(raw[i]);
+    }
+
+    inline void adc_ts_milli_pct_batch(const uint16_t *BQ2579X_RESTRICT raw, int32_t *BQ2579X_RESTRICT out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = static_cast<int32_t>(adc_ts_milli_pct(raw[i]));
+    }
+
+    inline void adc_tdie_dc_batch(const uint16_t *BQ2579X_RESTRICT raw, int32_t *BQ2579X_RESTRICT out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = adc_tdie_dc(raw[i]);
+    }
+
+    /// n mots bruts d'une voie vers l'unité de ADCSample ; le choix de formule est hors de la boucle
+    inline void adc_convert_batch(ADCChannel ch, const uint16_t *BQ2579X_RESTRICT raw, int32_t *BQ2579X_RESTRICT out, size_t n)
+    {
+        switch (ch)
+        {
+        case ADCChannel::IBAT:
+            adc_ibat_ma_batch(raw, out, n);
+            break;
+        case ADCChannel::TS:
+            adc_ts_milli_pct_batch(raw, out, n);
+            break;
+        case ADCChannel::TDIE:
+            adc_tdie_dc_batch(raw, out, n);
+            break;
+        default:
+            adc_unsigned_batch(raw, out, n);
+            break;
+        }
+    }
+
+    /// Colonne d'une voie de l'historique, dans l'ordre chronologique ; out doit contenir size() valeurs
+    template <size_t N>
+    size_t adc_convert_history(const ADCHistory<N> &history, ADCChannel ch, int32_t *out)
+    {
+        const uint16_t *column = history.raw(ch);
+        const size_t first = history.oldest();
+        const size_t tail = history.size() - first;
+        adc_convert_batch(ch, column + first, out, tail);
+        adc_convert_batch(ch, column, out + tail, first);
+        return history.size();
+    }
+
+} // namespace bq2579x
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bq2579x
+{
+    /// Voies ADC dans l'ordre des registres REG31h..REG45h
+    enum class ADCChannel : uint8_t
+    {
+        IBUS,
+        IBAT,
+        VBUS,
+        VAC1,
+        VAC2,
+        VBAT,
+        VSYS,
+        TS,
+        TDIE,
+        DPLUS,
+        DMINUS,
+        COUNT
+    };
+
+    static constexpr size_t ADC_CHANNEL_COUNT = static_cast<size_t>(ADCChannel::COUNT);
+    static constexpr uint16_t ADC_ALL_CHANNELS = (1u << ADC_CHANNEL_COUNT) - 1;
+
+    /// Bit de la voie dans les masques de voies (actives, valides)
+    constexpr uint16_t adc_channel_bit(ADCChannel ch)
+    {
+        return static_cast<uint16_t>(1u << static_cast<uint8_t>(ch));
+    }
+
+    /// Registre de poids fort du résultat (16 bits, big-endian)
+    constexpr uint8_t adc_channel_reg(ADCChannel ch)
+    {
+        return static_cast<uint8_t>(0x31 + 2 * static_cast<uint8_t>(ch));
+    }
+
+} // namespace bq2579x
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ctrl/bq2579x-adc_channel.hpp"
+
+// Sans dépendance ESP-IDF : utilisable côté hôte pour le post-traitement.
+
+namespace bq2579x
+{
+    // === Conversions brut → unités (communes aux registres, instantanés et historiques) ===
+
+    /// IBUS, LSB 1 mA
+    constexpr uint16_t adc_ibus_ma(uint16_t raw) { return raw; }
+
+    /// IBAT, complément à deux, LSB 1 mA
+    constexpr int16_t adc_ibat_ma(uint16_t raw) { return static_cast<int16_t>(raw); }
+
+    /// VBUS, VAC1, VAC2, VBAT, VSYS, D+, D-, LSB 1 mV
+    constexpr uint16_t adc_mv(uint16_t raw) { return raw; }
+
+    /// TS en millièmes de pourcent : 1 LSB = 0.0976563 % ≈ 250 / 256 milli-%
+    constexpr uint32_t adc_ts_milli_pct(uint16_t raw) { return (static_cast<uint32_t>(raw) * 250) / 256; }
+
+    /// TDIE en dixièmes de °C : complément à deux, LSB 0.5 °C
+    constexpr int16_t adc_tdie_dc(uint16_t raw) { return static_cast<int16_t>(static_cast<int16_t>(raw) * 5); }
+
+    /// Conversion d'une voie quelconque vers l'unité de ADCSample
+    constexpr int32_t adc_convert(ADCChannel ch, uint16_t raw)
+    {
+        switch (ch)
+        {
+        case ADCChannel::IBUS:
+            return adc_ibus_ma(raw);
+        case ADCChannel::IBAT:
+            return adc_ibat_ma(raw);
+        case ADCChannel::TS:
+            return static_cast<int32_t>(adc_ts_milli_pct(raw));
+        case ADCChannel::TDIE:
+            return adc_tdie_dc(raw);
+        default:
+            return adc_mv(raw);
+        }
+    }
+
+    /**
+     * @struct ADCSnapshot
+     * @brief Résultats ADC bruts d'une acquisition, contigus : 32 octets, alignés sur 8.
+     */
+    struct alignas(8) ADCSnapshot
+    {
+        int64_t timestamp_us = 0;
+        uint16_t raw[ADC_CHANNEL_COUNT] = {}; // ordre des registres REG31h..REG45h
+        uint16_t valid = 0;                   // voies lues (adc_channel_bit)
+
+        uint16_t get_raw(ADCChannel ch) const { return raw[static_cast<size_t>(ch)]; }
+        bool is_valid(ADCChannel ch) const { return valid & adc_channel_bit(ch); }
+
+        /// Valeur convertie, 0 si la voie n'a pas été lue
+        int32_t value(ADCChannel ch) const { return is_valid(ch) ? adc_convert(ch, get_raw(ch)) : 0; }
+    };
+
+    static_assert(sizeof(ADCSnapshot) == 32, "ADCSnapshot layout changed");
+
+    /**
+     * @class ADCHistory
+     * @brief Historique circulaire d'instantanés rangé par voie (structure de tableaux).
+     *
+     * Chaque voie occupe une colonne contiguë de N mots bruts : les boucles de
+     * conversion parcourent une seule voie sans sauts. L'ordre chronologique est
+     * [oldest(), N) puis [0, oldest()) une fois l'historique plein.
+     */
+    template <size_t N>
+    class ADCHistory
+    {
+        static_assert(N >= 1, "history needs at least one slot");
+
+    public:
+        void push(const ADCSnapshot &s)
+        {
+            timestamp_us_[head_] = s.timestamp_us;
+            valid_[head_] = s.valid;
+            for (size_t c = 0; c < ADC_CHANNEL_COUNT; ++c)
+                raw_[c][head_] = s.raw[c];
+            head_ = (head_ + 1) % N;
+            if (size_ < N)
+                size_++;
+        }
+
+        /// i-ème instantané, 0 = le plus ancien
+        ADCSnapshot at(size_t i) const
+        {
+            const size_t idx = (oldest() + i) % N;
+            ADCSnapshot s;
+            s.timestamp_us = timestamp_us_[idx];
+            s.valid = valid_[idx];
+            for (size_t c = 0; c < ADC_CHANNEL_COUNT; ++c)
+                s.raw[c] = raw_[c][idx];
+            return s;
+        }
+
+        const uint16_t *raw(ADCChannel ch) const { return raw_[static_cast<size_t>(ch)]; }
+        const int64_t *timestamps() const { return timestamp_us_; }
+        const uint16_t *valid() const { return valid_; }
+
+        size_t oldest() const { return size_ < N ? 0 : head_; }
+        size_t size() const { return size_; }
+        static constexpr size_t capacity() { return N; }
+
+        void clear()
+        {
+            head_ = 0;
+            size_ = 0;
+        }
+
+    private:
+        alignas(16) uint16_t raw_[ADC_CHANNEL_COUNT][N] = {};
+        alignas(16) int64_t timestamp_us_[N] = {};
+        uint16_t valid_[N] = {};
+        size_t head_ = 0;
+        size_t size_ = 0;
+    };
+
+} // namespace bq2579x
@@ -4,6 +4,10 @@
 
 #include "ctrl/bq2579x-ctrl_types.hpp"
 #include "bq2579x-interface.hpp"
+#include "bq2579x-json_writer.hpp"
+#include "bq2579x-stream.hpp"
+#include "ctrl/bq2579x-adc_channel.hpp"
+#include "ctrl/bq2579x-adc_snapshot.hpp"
 
 namespace bq2579x
 {
@@ -14,22 +18,21 @@ namespace bq2579x
         explicit CTRL(I2CDevices &dev) : INTERFACE(dev) {}
 
         ICO_Current_Limit_Register ico_current_limit_ma = {};
-        IBUS_ADC_Register ibus_adc_ma = {};
-        IBAT_ADC_Register ibat_adc_ma = {};
-        VBUS_ADC_Register vbus_adc_mv = {};
-        VAC1_ADC_Register vac1_adc_mv = {};
-        VAC2_ADC_Register vacd2_adc_mv = {};
-        VBAT_ADC_Register vbat_adc_mv = {};
-        VSYS_ADC_Register vsys_adc_mv = {};
-        TS_ADC_Register ts_adc_mp = {};
-        TDIE_ADC_Register tdie_adc_dc = {};
-        DPlus_ADC_Register dplus_adc_mv = {};
-        DMinus_ADC_Register dminus_adc_mv = {};
-        
+
         esp_err_t ready();
         esp_err_t send_reset();
 
         esp_err_t en_adc();
+
+        /// Lance une conversion one-shot et rend la main dès ADC_DONE_STAT (REG1Eh bit 5)
+        /// expected_us : durée de conversion attendue, aucune lecture du bus avant ; ensuite
+        /// un sondage par tick FreeRTOS
+        esp_err_t convert_oneshot(uint32_t expected_us, uint32_t timeout_us);
+        /// Conversion terminée (ADC_DONE_STAT) : sondage sans attente, pour un appelant qui planifie lui-même
+        esp_err_t adc_done(bool &done);
+        static constexpr uint32_t ADC_POLL_US = 500;
+        /// Au-delà, convert_oneshot() attend par vTaskDelay plutôt qu'en boucle active
+        static constexpr uint32_t ADC_SPIN_MAX_US = 1000;
         esp_err_t get_ico_current_limit();
         esp_err_t get_ibus_adc();
         esp_err_t get_ibat_adc();
@@ -42,10 +45,52 @@ namespace bq2579x
         esp_err_t get_tdie_adc();
         esp_err_t get_dplus_adc();
         esp_err_t get_dminus_adc();
+        esp_err_t get_adc();
+
+        /// Lit uniquement les voies données (parmi les voies actives) ; les autres gardent leur valeur mais ne sont plus valides
+        esp_err_t get_adc(uint16_t channels);
         esp_err_t get();
 
+        /// Décode le bloc ADC contigu (ADC_BLOCK_START..ADC_BLOCK_START + ADC_BLOCK_LEN - 1)
+        void decode_adc_block(const uint8_t *block, uint16_t channels = ADC_ALL_CHANNELS);
+
+        // Bloc ADC REG31h..REG46h lu en une seule transaction (auto-incrément)
+        static constexpr uint8_t ADC_BLOCK_START = adc_channel_reg(ADCChannel::IBUS);
+        static constexpr size_t ADC_BLOCK_LEN = (adc_channel_reg(ADCChannel::DMINUS) + 2) - ADC_BLOCK_START;
+
+        /// Rafales I2C couvrant les voies actives
+        struct ADCReadPlan
+        {
+            struct Span
+            {
+                uint8_t reg;
+                uint8_t len;
+            };
+            Span spans[ADC_CHANNEL_COUNT] = {};
+            uint8_t count = 0;
+            uint16_t channels = 0;
+        };
+
+        /// Regroupe les voies actives ; un trou plus court que le coût d'une transaction est relu
+        static ADCReadPlan plan_adc_reads(uint16_t channels);
+
+        /// Restreint get_adc() aux voies données (ConfigADC::enabled_channels())
+        void set_adc_channels(uint16_t channels);
+        const ADCReadPlan &adc_plan() const { return adc_plan_; }
+
+        /// Dernière acquisition ADC : valeurs brutes, voies lues et horodatage
+        const ADCSnapshot &adc_snapshot() const { return adc_snapshot_; }
+
+        /// Voies lues lors de la dernière acquisition (masque adc_channel_bit)
+        uint16_t adc_valid() const { return adc_snapshot_.valid; }
+        bool adc_valid(ADCChannel ch) const { return adc_snapshot_.is_valid(ch); }
+
+        /// Convertit les dernières valeurs ADC lues en échantillon virgule fixe (sans horodatage)
+        void to_sample(ADCSample &out) const;
+
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_CTRL";
@@ -55,6 +100,18 @@ namespace bq2579x
         static constexpr uint8_t VALUE_DEVICE_ID  = 0x03;
         static constexpr uint16_t RESET_COMMAND = 1 << 3; // [3] Watchdog Reset (0 = pas de reset, 1 = reset)
         static constexpr uint16_t EN_ADC_COMMAND = 1 << 7;
+        static constexpr uint8_t REG_CHARGER_STATUS3 = 0x1E;
+        static constexpr uint8_t ADC_DONE_STAT = 1 << 5;
+        // START + adresse (W) + registre + RESTART + adresse (R) : ~3 octets par transaction
+        static constexpr size_t ADC_TRANSACTION_OVERHEAD_BYTES = 3;
+
+        ADCReadPlan adc_plan_ = plan_adc_reads(ADC_ALL_CHANNELS);
+        ADCSnapshot adc_snapshot_ = {};
+
+        esp_err_t get_adc_channel(ADCChannel ch);
+        esp_err_t read_adc_plan(const ADCReadPlan &plan);
+
+        void log_channel(ADCChannel ch, const char *label, int value, const char *unit) const;
 
 
     };
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "ctrl/bq2579x-adc_snapshot.hpp"
+
 namespace bq2579x
 {
 // REG19h - ICO Current Limit (Read Only)
@@ -31,7 +33,7 @@ public:
 
     // Retourne le courant en mA (signé) basé sur un offset fixe à 0 et un pas de 1 mA
     uint16_t get_value() const {
-        return static_cast<uint16_t>(raw_);
+        return adc_ibus_ma(raw_);
     }
 
 private:
@@ -48,7 +50,7 @@ public:
 
     // Retourne le courant batterie en mA (signé)
     int16_t get_value() const {
-        return static_cast<int16_t>(raw_);
+        return adc_ibat_ma(raw_);
     }
 
 private:
@@ -65,7 +67,7 @@ public:
 
     // Retourne la tension VBUS en millivolts
     uint16_t get_value() const {
-        return raw_; // LSB = 1mV
+        return adc_mv(raw_); // LSB = 1mV
     }
 
 private:
@@ -82,7 +84,7 @@ public:
 
     // Retourne la tension VAC1 en millivolts
     uint16_t get_value() const {
-        return raw_; // LSB = 1mV
+        return adc_mv(raw_); // LSB = 1mV
     }
 
 private:
@@ -99,7 +101,7 @@ public:
 
     // Retourne la tension VAC2 en millivolts
     uint16_t get_value() const {
-        return raw_; // LSB = 1mV
+        return adc_mv(raw_); // LSB = 1mV
     }
 
 private:
@@ -116,7 +118,7 @@ public:
 
     // Retourne la tension VBAT en millivolts
     uint16_t get_value() const {
-        return raw_; // LSB = 1mV
+        return adc_mv(raw_); // LSB = 1mV
     }
 
 private:
@@ -133,7 +135,7 @@ public:
 
     // Retourne la tension VSYS en millivolts
     uint16_t get_value() const {
-        return raw_; // LSB = 1mV
+        return adc_mv(raw_); // LSB = 1mV
     }
 
 private:
@@ -150,10 +152,8 @@ public:
 
     // Retourne la valeur en millièmes de pourcent (par exemple : 12345 => 12.345 %)
     uint32_t get_value() const {
-        // 1 LSB = 0.0976563 %
-        // 0.0976563 * 1000 ≈ 97.6563 milli-%
-        // Utilisation d'un facteur entier (97.65625 ≈ 250 / 256)
-        return (static_cast<uint32_t>(raw_) * 250) / 256;
+        // 1 LSB = 0.0976563 % ≈ 250 / 256 milli-%
+        return adc_ts_milli_pct(raw_);
     }
 
 private:
@@ -170,8 +170,7 @@ public:
 
     // Retourne la température en dixièmes de degrés Celsius (par exemple : 253 => 25.3°C)
     int16_t get_value() const {
-        int16_t signed_val = static_cast<int16_t>(raw_);
-        return signed_val * 5; // 0.5°C * 10 = 5 dixièmes
+        return adc_tdie_dc(raw_); // 0.5°C * 10 = 5 dixièmes
     }
 
 private:
@@ -188,7 +187,7 @@ public:
 
     // Retourne la tension D+ en millivolts (entier)
     uint16_t get_value() const {
-        return raw_; // LSB = 1 mV
+        return adc_mv(raw_); // LSB = 1 mV
     }
 
 private:
@@ -205,7 +204,7 @@ public:
 
     // Retourne la tension D- en millivolts (entier uniquement)
     uint16_t get_value() const {
-        return raw_; // LSB = 1 mV
+        return adc_mv(raw_); // LSB = 1 mV
     }
 
 private:
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "esp_err.h"
+#include "sdkconfig.h"
+
+#include "status/bq2579x-status.hpp"
+
+namespace bq2579x
+{
+    /// Un événement par bit de flag REG22h..REG27h (changement signalé par le composant)
+    enum class ChargerEvent : uint8_t
+    {
+        // REG22h - Charger Flag 0
+        IINDPM,
+        VINDPM,
+        WATCHDOG,
+        POOR_SOURCE,
+        POWER_GOOD,
+        AC2_PRESENT,
+        AC1_PRESENT,
+        VBUS_PRESENT,
+        // REG23h - Charger Flag 1
+        CHG_STATE,
+        ICO,
+        VBUS_STATE,
+        TREG,
+        VBAT_PRESENT,
+        BC12_DONE,
+        // REG24h - Charger Flag 2
+        DPDM_DONE,
+        ADC_DONE,
+        VSYS_REG,
+        CHG_TIMER,
+        TRICKLE_TIMER,
+        PRECHG_TIMER,
+        TOPOFF_TIMER,
+        // REG25h - Charger Flag 3
+        VBATOTG_LOW,
+        TS_COLD,
+        TS_COOL,
+        TS_WARM,
+        TS_HOT,
+        // REG26h - Fault Flag 0
+        IBAT_REG,
+        VBUS_OVP,
+        VBAT_OVP,
+        IBUS_OCP,
+        IBAT_OCP,
+        CONV_OCP,
+        VAC2_OVP,
+        VAC1_OVP,
+        // REG27h - Fault Flag 1
+        VSYS_SHORT,
+        VSYS_OVP,
+        OTG_OVP,
+        OTG_UVP,
+        TSHUT,
+        COUNT
+    };
+
+    constexpr uint64_t event_bit(ChargerEvent e)
+    {
+        return 1ULL << static_cast<uint8_t>(e);
+    }
+
+    static constexpr uint64_t EVENTS_ALL = (1ULL << static_cast<uint8_t>(ChargerEvent::COUNT)) - 1;
+
+    /// Défauts matériels (Fault Flag 0/1)
+    static constexpr uint64_t EVENTS_FAULTS =
+        event_bit(ChargerEvent::IBAT_REG) | event_bit(ChargerEvent::VBUS_OVP) | event_bit(ChargerEvent::VBAT_OVP) |
+        event_bit(ChargerEvent::IBUS_OCP) | event_bit(ChargerEvent::IBAT_OCP) | event_bit(ChargerEvent::CONV_OCP) |
+        event_bit(ChargerEvent::VAC2_OVP) | event_bit(ChargerEvent::VAC1_OVP) | event_bit(ChargerEvent::VSYS_SHORT) |
+        event_bit(ChargerEvent::VSYS_OVP) | event_bit(ChargerEvent::OTG_OVP) | event_bit(ChargerEvent::OTG_UVP) |
+        event_bit(ChargerEvent::TSHUT);
+
+    const char *to_string(ChargerEvent e);
+
+    /// Alerte décodée : événements et statuts lus dans la même transaction
+    struct ChargerEventMessage
+    {
+        int64_t timestamp_us = 0;
+        uint64_t events = 0; // masque event_bit
+        uint8_t status[STATUS::STATUS_BLOCK_LEN] = {}; // REG1Bh..REG21h au moment de l'alerte
+
+        bool has(ChargerEvent e) const { return events & event_bit(e); }
+
+        ChargerStatus0Register::Values charger_status0() const;
+        ChargerStatus1Register::Values charger_status1() const;
+        FaultStatus0Register::Values fault_status0() const;
+        FaultStatus1Register::Values fault_status1() const;
+    };
+
+    /// Décode les flags du dernier instantané STATUS en événements
+    uint64_t decode_events(const STATUS &status);
+
+    /// Position du flag d'un événement : registre (0 = REG22h) et bit ; même position dans les masques REG28h..REG2Dh
+    bool event_flag_bit(ChargerEvent e, size_t &reg, uint8_t &bit);
+
+    /// Nombre de registres de flags à lire depuis REG22h pour couvrir tous les événements non masqués (masks : REG28h..REG2Dh)
+    size_t unmasked_flags_span(const uint8_t (&masks)[STATUS::FLAGS_BLOCK_LEN]);
+
+    /// Appelé dans la tâche d'alerte : ne doit ni bloquer ni accéder au bus
+    using ChargerEventCallback = void (*)(const ChargerEventMessage &msg, void *ctx);
+
+    /**
+     * @class EVENT_DISPATCHER
+     * @brief Diffuse les alertes décodées aux abonnés, chacun filtré par son masque d'événements.
+     *
+     * Un abonné reçoit le message par rappel ou par file FreeRTOS (envoi sans attente,
+     * message perdu et compté si la file est pleine). Les abonnés disposent des statuts
+     * dans le message et n'ont jamais à relire les registres.
+     */
+    class EVENT_DISPATCHER
+    {
+    public:
+        static constexpr size_t MAX_SUBSCRIBERS = CONFIG_BQ25798_EVENT_SUBSCRIBERS;
+
+        esp_err_t subscribe(uint64_t mask, ChargerEventCallback callback, void *ctx, int *id = nullptr);
+
+        /// File d'éléments ChargerEventMessage
+        esp_err_t subscribe(uint64_t mask, QueueHandle_t queue, int *id = nullptr);
+
+        esp_err_t unsubscribe(int id);
+
+        void dispatch(const ChargerEventMessage &msg);
+
+        /// Messages perdus faute de place dans une file
+        uint32_t dropped() const;
+
+    private:
+        struct Subscriber
+        {
+            uint64_t mask = 0;
+            ChargerEventCallback callback = nullptr;
+            void *ctx = nullptr;
+            QueueHandle_t queue = nullptr;
+        };
+
+        mutable portMUX_TYPE lock_ = portMUX_INITIALIZER_UNLOCKED;
+        Subscriber subscribers_[MAX_SUBSCRIBERS] = {};
+        uint32_t dropped_ = 0;
+
+        esp_err_t add(const Subscriber &sub, int *id);
+    };
+
+} // namespace bq2579x
@@ -46,11 +46,34 @@ namespace bq2579x
         esp_err_t get_flags();
         esp_err_t get_status();
 
+        /// Lit statuts et flags (REG1Bh..REG27h) en une seule transaction : instantané cohérent
+        esp_err_t get_snapshot();
+        /// Idem en s'arrêtant après flags_len registres de flags ; les flags non lus sont décodés à 0
+        esp_err_t get_snapshot(size_t flags_len);
+        /// Lit sans décoder les registres de flags [first, end) (rangs depuis REG22h) : efface ce qui y est resté levé
+        esp_err_t discard_flags(size_t first, size_t end);
+
+        void decode_status_block(const uint8_t *block);
+        void decode_flags_block(const uint8_t *block);
+        void decode_snapshot(const uint8_t *block);
+
+        // Fenêtre contiguë REG1Bh..REG21h (statuts) suivie de REG22h..REG27h (flags, lecture = effacement)
+        static constexpr uint8_t STATUS_BLOCK_START = ChargerStatus0Register::reg_addr;
+        static constexpr size_t STATUS_BLOCK_LEN = (FaultStatus1Register::reg_addr + 1) - STATUS_BLOCK_START;
+        static constexpr uint8_t FLAGS_BLOCK_START = ChargerFlag0Register::reg_addr;
+        static constexpr size_t FLAGS_BLOCK_LEN = (FaultFlag1Register::reg_addr + 1) - FLAGS_BLOCK_START;
+        static constexpr uint8_t SNAPSHOT_START = STATUS_BLOCK_START;
+        static constexpr size_t SNAPSHOT_LEN = STATUS_BLOCK_LEN + FLAGS_BLOCK_LEN;
+
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_STATUS";
     };
 
+    static_assert(STATUS::STATUS_BLOCK_START + STATUS::STATUS_BLOCK_LEN == STATUS::FLAGS_BLOCK_START,
+                  "status and flag registers must be contiguous");
+
 } // namespace bq2579x
\ No newline at end of file
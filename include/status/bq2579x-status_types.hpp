@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <string>
 
+#include "bq2579x-json_writer.hpp"
+
 namespace bq2579x
 {
 
@@ -30,6 +32,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerStatus0Register";
@@ -88,12 +91,16 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerStatus1Register";
         uint8_t raw_ = 0;
     };
 
+    const char *to_string(ChargerStatus1Register::ChargeStatus status);
+    const char *to_string(ChargerStatus1Register::VbusStatus status);
+
     // REG1Dh - Charger Status 2
     class ChargerStatus2Register
     {
@@ -123,6 +130,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerStatus2Register";
@@ -153,6 +161,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerStatus3Register";
@@ -181,6 +190,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_ChargerStatus4Register";
@@ -212,6 +222,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_FaultStatus0Register";
@@ -240,6 +251,7 @@ namespace bq2579x
 
         void log() const;
         std::string to_json() const;
+        void write_json(JsonWriter &w) const;
 
     private:
         inline static const char *TAG = "BQ2579X_FaultStatus1Register";
@@ -0,0 +1,81 @@
+#include "bq2579x-adc_rate_groups.hpp"
+
+namespace bq2579x
+{
+#ifdef CONFIG_BQ25798_RATE_GROUPS
+    const ADCRateGroup ADC_RATE_GROUPS::DEFAULT_GROUPS[] = {
+        // Grandeurs thermiques : évoluent en secondes
+        {adc_channel_bit(ADCChannel::TS) | adc_channel_bit(ADCChannel::TDIE), CONFIG_BQ25798_RATE_THERMAL_PERIOD_MS},
+    };
+    const size_t ADC_RATE_GROUPS::DEFAULT_GROUP_COUNT = sizeof(DEFAULT_GROUPS) / sizeof(DEFAULT_GROUPS[0]);
+#else
+    // Sans groupes par défaut : toutes les voies à chaque tour
+    const ADCRateGroup ADC_RATE_GROUPS::DEFAULT_GROUPS[1] = {};
+    const size_t ADC_RATE_GROUPS::DEFAULT_GROUP_COUNT = 0;
+#endif
+
+    ADC_RATE_GROUPS::ADC_RATE_GROUPS()
+    {
+        set_groups(DEFAULT_GROUPS, DEFAULT_GROUP_COUNT);
+    }
+
+    esp_err_t ADC_RATE_GROUPS::set_groups(const ADCRateGroup *groups, size_t count)
+    {
+        if (count > MAX_GROUPS || (count > 0 && groups == nullptr))
+            return ESP_ERR_INVALID_ARG;
+
+        uint16_t grouped = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (groups[i].channels & grouped)
+                return ESP_ERR_INVALID_ARG;
+            grouped |= groups[i].channels;
+        }
+
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < count; ++i)
+        {
+            groups_[i] = groups[i];
+            next_due_us_[i] = 0;
+        }
+        count_ = count;
+        grouped_ = grouped & ADC_ALL_CHANNELS;
+        portEXIT_CRITICAL(&lock_);
+        return ESP_OK;
+    }
+
+    uint16_t ADC_RATE_GROUPS::due(int64_t now_us, uint32_t merge_us)
+    {
+        portENTER_CRITICAL(&lock_);
+        uint16_t channels = ADC_ALL_CHANNELS & ~grouped_;
+        for (size_t i = 0; i < count_; ++i)
+        {
+            const ADCRateGroup &g = groups_[i];
+            if (g.period_ms == 0)
+            {
+                channels |= g.channels;
+                continue;
+            }
+            if (next_due_us_[i] - now_us > static_cast<int64_t>(merge_us))
+                continue;
+
+            channels |= g.channels;
+            const int64_t period_us = static_cast<int64_t>(g.period_ms) * 1000;
+            next_due_us_[i] += period_us;
+            // Retard de plus d'une période (démarrage, tâche bloquée) : recaler sans rattrapage
+            if (next_due_us_[i] <= now_us)
+                next_due_us_[i] = now_us + period_us;
+        }
+        portEXIT_CRITICAL(&lock_);
+        return channels;
+    }
+
+    void ADC_RATE_GROUPS::restart()
+    {
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < count_; ++i)
+            next_due_us_[i] = 0;
+        portEXIT_CRITICAL(&lock_);
+    }
+
+} // namespace bq2579x
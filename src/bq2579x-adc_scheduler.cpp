@@ -0,0 +1,58 @@
+#include "bq2579x-adc_scheduler.hpp"
+
+namespace bq2579x
+{
+    using ChargeStatus = ChargerStatus1Register::ChargeStatus;
+    using VbusStatus = ChargerStatus1Register::VbusStatus;
+    using Resolution = ADCControlRegister::ADCSampleResolution;
+
+    const ADCPolicyRule ADC_SCHEDULER::DEFAULT_RULES[] = {
+        // Charge en cours : suivi serré du courant et de la tension
+        {charge_bit(ChargeStatus::FastCharge) | charge_bit(ChargeStatus::TaperCharge),
+         VBUS_ANY, {false, Resolution::RES_12_BIT, 250}},
+        {charge_bit(ChargeStatus::TrickleCharge) | charge_bit(ChargeStatus::PreCharge) | charge_bit(ChargeStatus::TopOffCharge),
+         VBUS_ANY, {false, Resolution::RES_13_BIT, 1000}},
+        // Sur batterie, sans charge : conversion ponctuelle et rare
+        {charge_bit(ChargeStatus::NotCharging) | charge_bit(ChargeStatus::TerminationDone),
+         vbus_bit(VbusStatus::NoInput) | vbus_bit(VbusStatus::BackupMode), {true, Resolution::RES_15_BIT, 30000}},
+    };
+    const size_t ADC_SCHEDULER::DEFAULT_RULE_COUNT = sizeof(DEFAULT_RULES) / sizeof(DEFAULT_RULES[0]);
+
+    // Alimenté mais sans charge (terminée, désactivée, OTG...)
+    const ADCSchedule ADC_SCHEDULER::DEFAULT_FALLBACK = {true, Resolution::RES_14_BIT, 5000};
+
+    ADC_SCHEDULER::ADC_SCHEDULER()
+    {
+        set_policy(DEFAULT_RULES, DEFAULT_RULE_COUNT, DEFAULT_FALLBACK);
+    }
+
+    esp_err_t ADC_SCHEDULER::set_policy(const ADCPolicyRule *rules, size_t count, const ADCSchedule &fallback)
+    {
+        if (count > MAX_RULES || (count > 0 && rules == nullptr))
+            return ESP_ERR_INVALID_ARG;
+        if (fallback.period_ms == 0)
+            return ESP_ERR_INVALID_ARG;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (rules[i].schedule.period_ms == 0)
+                return ESP_ERR_INVALID_ARG;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            rules_[i] = rules[i];
+        count_ = count;
+        fallback_ = fallback;
+        return ESP_OK;
+    }
+
+    const ADCSchedule &ADC_SCHEDULER::select(ChargeStatus charge, VbusStatus vbus) const
+    {
+        for (size_t i = 0; i < count_; ++i)
+        {
+            if ((rules_[i].charge_mask & charge_bit(charge)) && (rules_[i].vbus_mask & vbus_bit(vbus)))
+                return rules_[i].schedule;
+        }
+        return fallback_;
+    }
+
+} // namespace bq2579x
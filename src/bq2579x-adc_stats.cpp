@@ -0,0 +1,174 @@
+#include "bq2579x-adc_stats.hpp"
+
+namespace bq2579x
+{
+    namespace
+    {
+        uint64_t isqrt(uint64_t v)
+        {
+            uint64_t result = 0;
+            uint64_t bit = 1ULL << 62;
+            while (bit > v)
+                bit >>= 2;
+            while (bit != 0)
+            {
+                if (v >= result + bit)
+                {
+                    v -= result + bit;
+                    result = (result >> 1) + bit;
+                }
+                else
+                {
+                    result >>= 1;
+                }
+                bit >>= 2;
+            }
+            return result;
+        }
+
+        // Division arrondie au plus proche : évite la dérive de la moyenne par troncature
+        int64_t div_round(int64_t num, int64_t den)
+        {
+            return num >= 0 ? (num + den / 2) / den : -((-num + den / 2) / den);
+        }
+    }
+
+    uint32_t ChannelStats::stddev_q() const
+    {
+        return static_cast<uint32_t>(isqrt(variance_q()));
+    }
+
+    void ADCStatsWindow::write_json(JsonWriter &w) const
+    {
+        static const char *const NAMES[ADC_CHANNEL_COUNT] = {
+            "ibus_ma", "ibat_ma", "vbus_mv", "vac1_mv", "vac2_mv", "vbat_mv",
+            "vsys_mv", "ts_milli_pct", "tdie_dc", "dplus_mv", "dminus_mv"};
+        constexpr double SCALE = ChannelStats::SCALE;
+
+        w.raw("{\"start_us\": ")
+            .value(static_cast<long long>(start_us))
+            .raw(",\"end_us\": ")
+            .value(static_cast<long long>(end_us));
+        for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+        {
+            if (!(channels & (1u << i)))
+                continue;
+            const ChannelStats &s = ch[i];
+            w.raw(",\"").raw(NAMES[i]).raw("\": {\"count\": ").value(s.count);
+            if (s.count == 0)
+            {
+                w.raw("}");
+                continue;
+            }
+            w.raw(",\"min\": ").value(s.min)
+                .raw(",\"max\": ").value(s.max)
+                .raw(",\"mean\": ").value(s.mean_q / SCALE)
+                .raw(",\"ewma\": ").value(s.ewma_q / SCALE)
+                .raw(",\"stddev\": ").value(s.stddev_q() / SCALE)
+                .raw("}");
+        }
+        w.raw("}");
+    }
+
+    void ADC_STATS::configure(uint16_t channels, uint8_t ewma_shift, uint32_t window_samples)
+    {
+        portENTER_CRITICAL(&lock_);
+        channels_ = channels & ADC_ALL_CHANNELS;
+        ewma_shift_ = ewma_shift > 15 ? 15 : ewma_shift;
+        // 0 : pas de fermeture périodique, mais jamais au-delà du débordement de m2_q
+        window_samples_ = (window_samples == 0 || window_samples > MAX_WINDOW_SAMPLES) ? MAX_WINDOW_SAMPLES : window_samples;
+        ewma_started_ = 0;
+        has_last_ = false;
+        open_window();
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    void ADC_STATS::open_window()
+    {
+        current_ = {};
+        current_.channels = channels_;
+        samples_ = 0;
+    }
+
+    void ADC_STATS::add(const ADCSample &sample)
+    {
+        portENTER_CRITICAL(&lock_);
+        if (samples_ == 0)
+            current_.start_us = sample.timestamp_us;
+        current_.end_us = sample.timestamp_us;
+        samples_++;
+
+        const uint16_t tracked = channels_ & sample.valid;
+        for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+        {
+            if (!(tracked & (1u << i)))
+                continue;
+
+            ChannelStats &s = current_.ch[i];
+            const int32_t x = sample.value[i];
+            const int64_t x_q = static_cast<int64_t>(x) * ChannelStats::SCALE;
+
+            s.count++;
+            if (x < s.min)
+                s.min = x;
+            if (x > s.max)
+                s.max = x;
+
+            // Welford : pas de Σx² qui déborderait sur une longue fenêtre
+            const int64_t delta = x_q - s.mean_q;
+            s.mean_q += div_round(delta, s.count);
+            s.m2_q += delta * (x_q - s.mean_q);
+
+            if (!(ewma_started_ & (1u << i)))
+            {
+                s.ewma_q = x_q;
+                ewma_started_ |= static_cast<uint16_t>(1u << i);
+            }
+            else
+            {
+                s.ewma_q += div_round(x_q - s.ewma_q, int64_t(1) << ewma_shift_);
+            }
+        }
+
+        if (samples_ >= window_samples_)
+        {
+            last_ = current_;
+            has_last_ = true;
+            open_window();
+            // L'EWMA ne dépend pas de la fenêtre
+            for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+                current_.ch[i].ewma_q = last_.ch[i].ewma_q;
+        }
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    void ADC_STATS::read_and_reset(ADCStatsWindow &out)
+    {
+        portENTER_CRITICAL(&lock_);
+        out = current_;
+        open_window();
+        for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+            current_.ch[i].ewma_q = out.ch[i].ewma_q;
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    bool ADC_STATS::last_window(ADCStatsWindow &out) const
+    {
+        portENTER_CRITICAL(&lock_);
+        const bool available = has_last_;
+        if (available)
+            out = last_;
+        portEXIT_CRITICAL(&lock_);
+        return available;
+    }
+
+    void ADC_STATS::reset()
+    {
+        portENTER_CRITICAL(&lock_);
+        ewma_started_ = 0;
+        has_last_ = false;
+        open_window();
+        portEXIT_CRITICAL(&lock_);
+    }
+
+} // namespace bq2579x
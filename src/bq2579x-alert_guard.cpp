@@ -0,0 +1,122 @@
+#include "bq2579x-alert_guard.hpp"
+
+namespace bq2579x
+{
+    void ALERT_GUARD::configure(uint32_t min_interval_ms, uint16_t threshold, uint32_t window_ms, uint32_t backoff_ms)
+    {
+        portENTER_CRITICAL(&lock_);
+        min_interval_us_ = static_cast<int64_t>(min_interval_ms) * 1000;
+        threshold_ = threshold;
+        window_us_ = static_cast<int64_t>(window_ms ? window_ms : 1) * 1000;
+        backoff_us_ = static_cast<int64_t>(backoff_ms) * 1000;
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    int64_t ALERT_GUARD::service_delay_us(int64_t now_us) const
+    {
+        portENTER_CRITICAL(&lock_);
+        const int64_t delay = last_service_us_ + min_interval_us_ - now_us;
+        portEXIT_CRITICAL(&lock_);
+        return delay > 0 ? delay : 0;
+    }
+
+    uint64_t ALERT_GUARD::record(uint64_t events, int64_t now_us)
+    {
+        uint64_t to_mask = 0;
+        portENTER_CRITICAL(&lock_);
+        stats_.alerts++;
+        last_service_us_ = now_us;
+        if (now_us - window_start_us_ >= window_us_)
+        {
+            window_start_us_ = now_us;
+            for (uint16_t &c : counts_)
+                c = 0;
+        }
+
+        for (size_t i = 0; i < SOURCES; ++i)
+        {
+            const uint64_t bit = 1ULL << i;
+            // Source déjà masquée : son flag peut rester levé, il ne compte plus
+            if (!(events & bit) || (stats_.masked_events & bit))
+                continue;
+            if (counts_[i] < UINT16_MAX)
+                counts_[i]++;
+            if (threshold_ != 0 && counts_[i] > threshold_)
+            {
+                to_mask |= bit;
+                counts_[i] = 0;
+                unmask_at_us_[i] = now_us + backoff_us_;
+                stats_.masked_events |= bit;
+                stats_.masked++;
+            }
+        }
+        portEXIT_CRITICAL(&lock_);
+        return to_mask;
+    }
+
+    uint64_t ALERT_GUARD::expired(int64_t now_us)
+    {
+        uint64_t done = 0;
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < SOURCES; ++i)
+        {
+            const uint64_t bit = 1ULL << i;
+            if ((stats_.masked_events & bit) && now_us >= unmask_at_us_[i])
+            {
+                done |= bit;
+                stats_.masked_events &= ~bit;
+                stats_.unmasked++;
+            }
+        }
+        portEXIT_CRITICAL(&lock_);
+        return done;
+    }
+
+    int64_t ALERT_GUARD::next_unmask_us() const
+    {
+        int64_t next = INT64_MAX;
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < SOURCES; ++i)
+        {
+            if ((stats_.masked_events & (1ULL << i)) && unmask_at_us_[i] < next)
+                next = unmask_at_us_[i];
+        }
+        portEXIT_CRITICAL(&lock_);
+        return next;
+    }
+
+    void ALERT_GUARD::note_coalesced()
+    {
+        portENTER_CRITICAL(&lock_);
+        stats_.coalesced++;
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    void ALERT_GUARD::rollback(uint64_t masked, uint64_t unmasked, int64_t now_us)
+    {
+        portENTER_CRITICAL(&lock_);
+        stats_.masked_events &= ~masked;
+        stats_.masked_events |= unmasked;
+        for (size_t i = 0; i < SOURCES; ++i)
+        {
+            const uint64_t bit = 1ULL << i;
+            if (masked & bit)
+                stats_.masked--;
+            if (unmasked & bit)
+            {
+                stats_.unmasked--;
+                unmask_at_us_[i] = now_us + window_us_;
+            }
+        }
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    StormStats ALERT_GUARD::stats() const
+    {
+        portENTER_CRITICAL(&lock_);
+        StormStats copy = stats_;
+        portEXIT_CRITICAL(&lock_);
+        return copy;
+    }
+
+} // namespace bq2579x
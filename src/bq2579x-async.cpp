@@ -0,0 +1,163 @@
+#include "bq2579x-async.hpp"
+
+#include <cstring>
+
+#include "esp_log.h"
+
+namespace bq2579x
+{
+    ASYNC_INTERFACE::~ASYNC_INTERFACE()
+    {
+        stop();
+    }
+
+    esp_err_t ASYNC_INTERFACE::start(size_t queue_depth, UBaseType_t priority, BaseType_t core)
+    {
+        if (worker_ != nullptr)
+            return ESP_ERR_INVALID_STATE;
+
+        queue_ = xQueueCreate(queue_depth, sizeof(AsyncRequest));
+        if (queue_ == nullptr)
+            return ESP_ERR_NO_MEM;
+
+        if (xTaskCreatePinnedToCore(worker_entry, "BQ2579X_Bus", 3072, this, priority, &worker_, core) != pdPASS)
+        {
+            vQueueDelete(queue_);
+            queue_ = nullptr;
+            worker_ = nullptr;
+            return ESP_ERR_NO_MEM;
+        }
+        return ESP_OK;
+    }
+
+    void ASYNC_INTERFACE::stop()
+    {
+        if (worker_ == nullptr)
+            return;
+
+        AsyncRequest req;
+        req.op = AsyncOp::Stop;
+        req.notify_task = xTaskGetCurrentTaskHandle();
+        xQueueSend(queue_, &req, portMAX_DELAY);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        vQueueDelete(queue_);
+        queue_ = nullptr;
+        worker_ = nullptr;
+    }
+
+    esp_err_t ASYNC_INTERFACE::submit(const AsyncRequest &req, TickType_t wait)
+    {
+        if (queue_ == nullptr)
+            return ESP_ERR_INVALID_STATE;
+        if (req.op == AsyncOp::Write && req.len > AsyncRequest::MAX_WRITE_LEN)
+            return ESP_ERR_INVALID_SIZE;
+        if (req.op == AsyncOp::Read && req.data == nullptr)
+            return ESP_ERR_INVALID_ARG;
+
+        if (xQueueSend(queue_, &req, wait) != pdTRUE)
+        {
+            ESP_LOGW(TAG, "File pleine, requête reg 0x%02X refusée", req.reg);
+            return ESP_ERR_TIMEOUT;
+        }
+        return ESP_OK;
+    }
+
+    esp_err_t ASYNC_INTERFACE::submit_read(uint8_t reg, uint8_t *data, size_t len,
+                                           AsyncCallback callback, void *ctx, TickType_t wait)
+    {
+        AsyncRequest req;
+        req.op = AsyncOp::Read;
+        req.reg = reg;
+        req.len = len;
+        req.data = data;
+        req.callback = callback;
+        req.ctx = ctx;
+        return submit(req, wait);
+    }
+
+    esp_err_t ASYNC_INTERFACE::submit_write(uint8_t reg, const uint8_t *data, size_t len,
+                                            AsyncCallback callback, void *ctx, TickType_t wait)
+    {
+        if (len > AsyncRequest::MAX_WRITE_LEN)
+            return ESP_ERR_INVALID_SIZE;
+
+        AsyncRequest req;
+        req.op = AsyncOp::Write;
+        req.reg = reg;
+        req.len = len;
+        std::memcpy(req.payload, data, len);
+        req.callback = callback;
+        req.ctx = ctx;
+        return submit(req, wait);
+    }
+
+    esp_err_t ASYNC_INTERFACE::submit_read(uint8_t reg, uint8_t *data, size_t len,
+                                           esp_err_t *result, TickType_t wait)
+    {
+        AsyncRequest req;
+        req.op = AsyncOp::Read;
+        req.reg = reg;
+        req.len = len;
+        req.data = data;
+        req.notify_task = xTaskGetCurrentTaskHandle();
+        req.result = result;
+        return submit(req, wait);
+    }
+
+    esp_err_t ASYNC_INTERFACE::submit_write(uint8_t reg, const uint8_t *data, size_t len,
+                                            esp_err_t *result, TickType_t wait)
+    {
+        if (len > AsyncRequest::MAX_WRITE_LEN)
+            return ESP_ERR_INVALID_SIZE;
+
+        AsyncRequest req;
+        req.op = AsyncOp::Write;
+        req.reg = reg;
+        req.len = len;
+        std::memcpy(req.payload, data, len);
+        req.notify_task = xTaskGetCurrentTaskHandle();
+        req.result = result;
+        return submit(req, wait);
+    }
+
+    void ASYNC_INTERFACE::complete(const AsyncRequest &req, esp_err_t err)
+    {
+        if (req.result != nullptr)
+            *req.result = err;
+        if (req.callback != nullptr)
+            req.callback(req, err, req.ctx);
+        if (req.notify_task != nullptr)
+            xTaskNotifyGive(req.notify_task);
+    }
+
+    void ASYNC_INTERFACE::worker_entry(void *arg)
+    {
+        static_cast<ASYNC_INTERFACE *>(arg)->worker_loop();
+    }
+
+    void ASYNC_INTERFACE::worker_loop()
+    {
+        AsyncRequest req;
+        while (true)
+        {
+            if (xQueueReceive(queue_, &req, portMAX_DELAY) != pdTRUE)
+                continue;
+
+            switch (req.op)
+            {
+            case AsyncOp::Read:
+                complete(req, read_register(req.reg, req.data, req.len));
+                break;
+            case AsyncOp::Write:
+                complete(req, write_register(req.reg, req.payload, req.len));
+                break;
+            case AsyncOp::Stop:
+                complete(req, ESP_OK);
+                vTaskDelete(nullptr);
+                return;
+            }
+        }
+    }
+
+} // namespace bq2579x
@@ -0,0 +1,190 @@
+#include "bq2579x-energy.hpp"
+
+#include "esp_log.h"
+
+namespace bq2579x
+{
+    namespace
+    {
+        const char *TAG = "BQ2579X_ENERGY";
+
+        int64_t abs64(int64_t v) { return v < 0 ? -v : v; }
+
+        /// Aire ×2 du trapèze a0 → a1 sur dt, séparée en parties positive et négative
+        void split_area(int64_t a0, int64_t a1, int64_t dt, int64_t &pos2, int64_t &neg2)
+        {
+            pos2 = 0;
+            neg2 = 0;
+            if (a0 >= 0 && a1 >= 0)
+            {
+                pos2 = (a0 + a1) * dt;
+                return;
+            }
+            if (a0 <= 0 && a1 <= 0)
+            {
+                neg2 = -(a0 + a1) * dt;
+                return;
+            }
+            // Passage par zéro : deux triangles, aire ×2 = |a| × (dt × |a| / (|a0| + |a1|))
+            const int64_t span = abs64(a0) + abs64(a1);
+            const int64_t p = a0 > 0 ? a0 : a1;
+            const int64_t n = a0 > 0 ? -a1 : -a0;
+            pos2 = p * (dt * p / span);
+            neg2 = n * (dt * n / span);
+        }
+    }
+
+    void COULOMB_COUNTER::Accumulator::fold(int64_t &counter, int64_t area2, int64_t divisor)
+    {
+        // Reliquat conservé : aucune perte sur les petits intervalles
+        residual += area2;
+        const int64_t whole = residual / divisor;
+        counter += whole;
+        residual -= whole * divisor;
+    }
+
+    void COULOMB_COUNTER::set_storage(const EnergyStorage &storage)
+    {
+        portENTER_CRITICAL(&lock_);
+        storage_ = storage;
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    esp_err_t COULOMB_COUNTER::load()
+    {
+        if (storage_.load == nullptr)
+            return ESP_ERR_NOT_SUPPORTED;
+
+        EnergyCounters loaded;
+        esp_err_t err = storage_.load(loaded, storage_.ctx);
+        if (err != ESP_OK)
+            return err;
+
+        portENTER_CRITICAL(&lock_);
+        counters_ = loaded;
+        bat_.valid = false;
+        input_.valid = false;
+        portEXIT_CRITICAL(&lock_);
+        return ESP_OK;
+    }
+
+    esp_err_t COULOMB_COUNTER::save()
+    {
+        if (storage_.save == nullptr)
+            return ESP_ERR_NOT_SUPPORTED;
+        return storage_.save(counters(), storage_.ctx);
+    }
+
+    int64_t COULOMB_COUNTER::integrate(Point &prev, const Point &next, size_t acc_base,
+                                    int64_t &charge_in, int64_t &charge_out,
+                                    int64_t &energy_in, int64_t &energy_out)
+    {
+        if (!next.valid)
+            return 0;
+
+        int64_t skipped_us = 0;
+        int64_t dt = next.t_us - prev.t_us;
+        if (prev.valid && dt > 0)
+        {
+            if (dt > max_gap_us_)
+            {
+                skipped_us = dt - max_gap_us_;
+                dt = max_gap_us_;
+            }
+
+            int64_t pos2, neg2;
+            split_area(prev.current_ma, next.current_ma, dt, pos2, neg2);
+            acc_[acc_base + 0].fold(charge_in, pos2, 2);
+            acc_[acc_base + 1].fold(charge_out, neg2, 2);
+
+            // µW × µs = pJ ; ×2 pour le trapèze → nJ
+            split_area(prev.power_uw, next.power_uw, dt, pos2, neg2);
+            acc_[acc_base + 2].fold(energy_in, pos2, 2000);
+            acc_[acc_base + 3].fold(energy_out, neg2, 2000);
+        }
+        // dt <= 0 (horloge redémarrée, doublon) : nouvelle origine sans intégrer
+        prev = next;
+        return skipped_us;
+    }
+
+    void COULOMB_COUNTER::add(const ADCSample &sample)
+    {
+        Point bat;
+        bat.t_us = sample.timestamp_us;
+        bat.valid = sample.is_valid(ADCChannel::IBAT) && sample.is_valid(ADCChannel::VBAT);
+        bat.current_ma = sample.get(ADCChannel::IBAT);
+        bat.power_uw = static_cast<int64_t>(sample.get(ADCChannel::IBAT)) * sample.get(ADCChannel::VBAT);
+
+        Point input;
+        input.t_us = sample.timestamp_us;
+        input.valid = sample.is_valid(ADCChannel::IBUS) && sample.is_valid(ADCChannel::VBUS);
+        // IBUS est lu non signé par le registre ; en OTG le courant sort (complément à deux)
+        input.current_ma = static_cast<int16_t>(sample.get(ADCChannel::IBUS));
+        input.power_uw = static_cast<int64_t>(input.current_ma) * sample.get(ADCChannel::VBUS);
+
+        portENTER_CRITICAL(&lock_);
+        const int64_t bat_skipped = integrate(bat_, bat, 0, counters_.bat_charge_in, counters_.bat_charge_out,
+                                              counters_.bat_energy_in, counters_.bat_energy_out);
+        const int64_t input_skipped = integrate(input_, input, 4, counters_.input_charge_in, counters_.input_charge_out,
+                                                counters_.input_energy_in, counters_.input_energy_out);
+        // Un trou se compte une fois par échantillon, même s'il touche les deux voies
+        const int64_t skipped = bat_skipped > input_skipped ? bat_skipped : input_skipped;
+        if (skipped > 0)
+        {
+            counters_.gaps++;
+            counters_.gap_time_us += skipped;
+        }
+        if (save_interval_us_ > 0 && storage_.save != nullptr &&
+            sample.timestamp_us - last_save_us_ >= save_interval_us_)
+        {
+            last_save_us_ = sample.timestamp_us;
+            save_pending_ = true;
+        }
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    bool COULOMB_COUNTER::save_pending() const
+    {
+        portENTER_CRITICAL(&lock_);
+        const bool pending = save_pending_;
+        portEXIT_CRITICAL(&lock_);
+        return pending;
+    }
+
+    esp_err_t COULOMB_COUNTER::save_if_pending()
+    {
+        portENTER_CRITICAL(&lock_);
+        const bool pending = save_pending_;
+        save_pending_ = false;
+        portEXIT_CRITICAL(&lock_);
+        if (!pending)
+            return ESP_OK;
+
+        esp_err_t err = save();
+        if (err != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Sauvegarde des compteurs impossible : %s", esp_err_to_name(err));
+        }
+        return err;
+    }
+
+    EnergyCounters COULOMB_COUNTER::counters() const
+    {
+        portENTER_CRITICAL(&lock_);
+        EnergyCounters copy = counters_;
+        portEXIT_CRITICAL(&lock_);
+        return copy;
+    }
+
+    void COULOMB_COUNTER::reset()
+    {
+        portENTER_CRITICAL(&lock_);
+        counters_ = {};
+        for (auto &acc : acc_)
+            acc.residual = 0;
+        bat_.valid = false;
+        input_.valid = false;
+        portEXIT_CRITICAL(&lock_);
+    }
+
+} // namespace bq2579x
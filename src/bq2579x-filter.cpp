@@ -0,0 +1,252 @@
+#include "bq2579x-filter.hpp"
+
+#include <cstring>
+
+namespace bq2579x
+{
+    namespace
+    {
+        // Au-delà du décalage maximal : un écart résiduel sous 2^shift reste sous le demi-LSB de sortie
+        constexpr int IIR_FRACTION_BITS = 16;
+        static_assert(IIR_FRACTION_BITS > FilterSpec::MAX_IIR_SHIFT, "IIR output would freeze short of the input");
+
+        uint8_t ceil_log2(uint8_t v)
+        {
+            uint8_t bits = 0;
+            while ((1u << bits) < v)
+                bits++;
+            return bits;
+        }
+
+#ifdef CONFIG_BQ25798_FILTER
+        FilterSpec kconfig_spec(int type, int param)
+        {
+            switch (type)
+            {
+            case 1:
+                return FilterSpec::moving_average(static_cast<uint8_t>(param));
+            case 2:
+                return FilterSpec::median(static_cast<uint8_t>(param));
+            case 3:
+                return FilterSpec::iir(static_cast<uint8_t>(param));
+            case 4:
+                return FilterSpec::cic(CONFIG_BQ25798_FILTER_CIC_ORDER, static_cast<uint8_t>(param));
+            default:
+                return FilterSpec::none();
+            }
+        }
+#endif
+    }
+
+    size_t FilterSpec::arena_words() const
+    {
+        switch (type)
+        {
+        case FilterType::MovingAverage:
+        case FilterType::Median:
+            return length;
+        case FilterType::CIC:
+            return 2 * static_cast<size_t>(shift); // intégrateurs puis retards des peignes
+        default:
+            return 0;
+        }
+    }
+
+    bool FilterSpec::valid() const
+    {
+        switch (type)
+        {
+        case FilterType::None:
+            return true;
+        case FilterType::MovingAverage:
+            return length >= 1;
+        case FilterType::Median:
+            return length >= 1 && length <= MAX_MEDIAN && (length & 1);
+        case FilterType::IIR:
+            return shift <= MAX_IIR_SHIFT;
+        case FilterType::CIC:
+            return length >= 1 && shift >= 1 && shift <= MAX_CIC_ORDER &&
+                   shift * ceil_log2(length) <= CIC_GROWTH_BITS;
+        }
+        return false;
+    }
+
+    ADC_FILTER_BANK::ADC_FILTER_BANK()
+    {
+#ifdef CONFIG_BQ25798_FILTER
+        specs_[static_cast<size_t>(ADCChannel::IBUS)] =
+            kconfig_spec(CONFIG_BQ25798_FILTER_IBUS_TYPE, CONFIG_BQ25798_FILTER_IBUS_PARAM);
+        specs_[static_cast<size_t>(ADCChannel::IBAT)] =
+            kconfig_spec(CONFIG_BQ25798_FILTER_IBAT_TYPE, CONFIG_BQ25798_FILTER_IBAT_PARAM);
+        for (FilterSpec &spec : specs_)
+        {
+            if (!spec.valid())
+                spec = FilterSpec::none();
+        }
+#endif
+        layout();
+    }
+
+    void ADC_FILTER_BANK::layout()
+    {
+        // Appelé sous verrou (ou à la construction)
+        size_t offset = 0;
+        for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+        {
+            states_[i] = {};
+            states_[i].offset = static_cast<uint16_t>(offset);
+            offset += specs_[i].arena_words();
+        }
+        arena_used_ = offset;
+        std::memset(arena_, 0, sizeof(arena_));
+    }
+
+    esp_err_t ADC_FILTER_BANK::configure(ADCChannel ch, const FilterSpec &spec)
+    {
+        const size_t idx = static_cast<size_t>(ch);
+        if (idx >= ADC_CHANNEL_COUNT || !spec.valid())
+            return ESP_ERR_INVALID_ARG;
+
+        portENTER_CRITICAL(&lock_);
+        const size_t needed = arena_used_ - specs_[idx].arena_words() + spec.arena_words();
+        if (needed > ARENA_WORDS)
+        {
+            portEXIT_CRITICAL(&lock_);
+            return ESP_ERR_NO_MEM;
+        }
+        specs_[idx] = spec;
+        layout();
+        portEXIT_CRITICAL(&lock_);
+        return ESP_OK;
+    }
+
+    FilterSpec ADC_FILTER_BANK::spec(ADCChannel ch) const
+    {
+        portENTER_CRITICAL(&lock_);
+        FilterSpec copy = specs_[static_cast<size_t>(ch)];
+        portEXIT_CRITICAL(&lock_);
+        return copy;
+    }
+
+    void ADC_FILTER_BANK::reset()
+    {
+        portENTER_CRITICAL(&lock_);
+        layout();
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    void ADC_FILTER_BANK::apply(ADCSample &sample)
+    {
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+        {
+            if (specs_[i].type == FilterType::None || !(sample.valid & (1u << i)))
+                continue;
+            sample.value[i] = step(specs_[i], states_[i], sample.value[i]);
+        }
+        portEXIT_CRITICAL(&lock_);
+    }
+
+    int32_t ADC_FILTER_BANK::median_of(const int32_t *history, uint8_t n) const
+    {
+        // n ≤ MAX_MEDIAN : tri par insertion d'une copie locale
+        int32_t sorted[FilterSpec::MAX_MEDIAN];
+        for (uint8_t i = 0; i < n; ++i)
+        {
+            int32_t v = history[i];
+            uint8_t j = i;
+            while (j > 0 && sorted[j - 1] > v)
+            {
+                sorted[j] = sorted[j - 1];
+                --j;
+            }
+            sorted[j] = v;
+        }
+        return sorted[n / 2];
+    }
+
+    int32_t ADC_FILTER_BANK::step(const FilterSpec &spec, State &st, int32_t x)
+    {
+        int32_t *words = &arena_[st.offset];
+        switch (spec.type)
+        {
+        case FilterType::MovingAverage:
+        {
+            if (st.count == spec.length)
+                st.acc -= words[st.index];
+            else
+                st.count++;
+            words[st.index] = x;
+            st.acc += x;
+            st.index = static_cast<uint8_t>((st.index + 1) % spec.length);
+            // Arrondi au plus proche ; fenêtre partielle au démarrage
+            const int64_t half = st.count / 2;
+            return static_cast<int32_t>(st.acc >= 0 ? (st.acc + half) / st.count : -((-st.acc + half) / st.count));
+        }
+
+        case FilterType::Median:
+        {
+            words[st.index] = x;
+            st.index = static_cast<uint8_t>((st.index + 1) % spec.length);
+            if (st.count < spec.length)
+                st.count++;
+            // Fenêtre partielle : médiane des count premières valeurs (impair ou inférieure)
+            return median_of(words, st.count);
+        }
+
+        case FilterType::IIR:
+        {
+            const int64_t xq = static_cast<int64_t>(x) * (int64_t(1) << IIR_FRACTION_BITS);
+            if (!st.primed)
+            {
+                st.acc = xq;
+                st.primed = true;
+            }
+            st.acc += (xq - st.acc) / (int64_t(1) << spec.shift);
+            return static_cast<int32_t>((st.acc + (int64_t(1) << (IIR_FRACTION_BITS - 1))) >> IIR_FRACTION_BITS);
+        }
+
+        case FilterType::CIC:
+        {
+            // Arithmétique modulo 2^32 (Hogenauer) : exacte tant que la croissance tient dans CIC_GROWTH_BITS
+            uint32_t *integ = reinterpret_cast<uint32_t *>(words);
+            uint32_t *delay = integ + spec.shift;
+            uint32_t v = static_cast<uint32_t>(x);
+            for (uint8_t k = 0; k < spec.shift; ++k)
+            {
+                integ[k] += v;
+                v = integ[k];
+            }
+            if (!st.primed)
+            {
+                st.output = x;
+                st.primed = true;
+            }
+            if (++st.index < spec.length)
+                return st.output;
+            st.index = 0;
+            for (uint8_t k = 0; k < spec.shift; ++k)
+            {
+                const uint32_t in = v;
+                v -= delay[k];
+                delay[k] = in;
+            }
+            // Gain length^order ; les order premières sorties (régime transitoire) sont ignorées
+            if (st.count < spec.shift)
+            {
+                st.count++;
+                return st.output;
+            }
+            int64_t gain = 1;
+            for (uint8_t k = 0; k < spec.shift; ++k)
+                gain *= spec.length;
+            st.output = static_cast<int32_t>(static_cast<int32_t>(v) / gain);
+            return st.output;
+        }
+
+        default:
+            return x;
+        }
+    }
+
+} // namespace bq2579x
@@ -0,0 +1,192 @@
+#include "bq2579x-interface.hpp"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+
+namespace bq2579x
+{
+    namespace
+    {
+        /// Un seul bus par composant : Config, STATUS, CTRL et la tâche ASYNC_INTERFACE le partagent
+        SemaphoreHandle_t bus_lock()
+        {
+            static StaticSemaphore_t buffer;
+            static SemaphoreHandle_t lock = xSemaphoreCreateMutexStatic(&buffer);
+            return lock;
+        }
+
+        /// Transaction complète (tentatives et récupération comprises) sans accès intercalé d'une autre tâche
+        struct BusLock
+        {
+            BusLock() { xSemaphoreTake(bus_lock(), portMAX_DELAY); }
+            ~BusLock() { xSemaphoreGive(bus_lock()); }
+        };
+    }
+
+    template <typename Transfer>
+    esp_err_t INTERFACE::transfer(Transfer &&op, uint32_t deadline_us, uint8_t &attempts)
+    {
+        const int64_t start_us = esp_timer_get_time();
+        const uint32_t budget_us = deadline_us != 0 ? deadline_us : policy_.deadline_us;
+        const uint8_t max_attempts = policy_.max_attempts > 0 ? policy_.max_attempts : 1;
+        uint32_t backoff_us = policy_.backoff_floor_us;
+        esp_err_t err = ESP_FAIL;
+
+        for (uint8_t attempt = 0; attempt < max_attempts; ++attempt)
+        {
+            attempts = attempt + 1;
+            if (attempt > 0)
+                retries_.fetch_add(1, std::memory_order_relaxed);
+
+            err = op();
+            if (err == ESP_OK)
+            {
+                consecutive_failures_.store(0, std::memory_order_relaxed);
+                return ESP_OK;
+            }
+            on_attempt_failed();
+
+            if (attempt + 1 == max_attempts)
+                break;
+
+            // Pas de nouvelle tentative si elle ne peut pas aboutir avant l'échéance
+            const int64_t elapsed_us = esp_timer_get_time() - start_us;
+            if (budget_us != 0 && elapsed_us + backoff_us >= budget_us)
+            {
+                deadline_misses_.fetch_add(1, std::memory_order_relaxed);
+                err = ESP_ERR_TIMEOUT;
+                break;
+            }
+
+            backoff_wait(backoff_us);
+            backoff_us = backoff_us * 2 < policy_.backoff_max_us ? backoff_us * 2 : policy_.backoff_max_us;
+        }
+
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        return err;
+    }
+
+    esp_err_t INTERFACE::read_register(uint8_t reg, uint8_t *data, size_t len, uint32_t deadline_us)
+    {
+#ifdef CONFIG_BQ25798_BUS_STATS
+        const int64_t start_us = esp_timer_get_time();
+#endif
+        uint8_t attempts = 0;
+        esp_err_t err;
+        {
+            BusLock lock;
+            err = transfer([&]()
+                           {
+                               esp_err_t rc = i2c.read(reg, data, len);
+                               BQ2579X_TRACE(TraceDirection::Read, reg, len, rc);
+                               return rc;
+                           },
+                           deadline_us, attempts);
+        }
+#ifdef CONFIG_BQ25798_BUS_STATS
+        BUS_STATS::record(false, reg, len, attempts, err, static_cast<uint32_t>(esp_timer_get_time() - start_us));
+#endif
+        if (err != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Read failed at reg 0x%02X (err=0x%x)", reg, err);
+        }
+        return err;
+    }
+
+    esp_err_t INTERFACE::write_register(uint8_t reg, const uint8_t *data, size_t len, uint32_t deadline_us)
+    {
+#ifdef CONFIG_BQ25798_BUS_STATS
+        const int64_t start_us = esp_timer_get_time();
+#endif
+        uint8_t attempts = 0;
+        esp_err_t err;
+        {
+            BusLock lock;
+            err = transfer([&]()
+                           {
+                               esp_err_t rc = i2c.write(reg, data, len);
+                               BQ2579X_TRACE(TraceDirection::Write, reg, len, rc);
+                               return rc;
+                           },
+                           deadline_us, attempts);
+        }
+#ifdef CONFIG_BQ25798_BUS_STATS
+        BUS_STATS::record(true, reg, len, attempts, err, static_cast<uint32_t>(esp_timer_get_time() - start_us));
+#endif
+        if (err != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Write failed at reg 0x%02X (err=0x%x)", reg, err);
+        }
+        return err;
+    }
+
+    void INTERFACE::on_attempt_failed()
+    {
+        const uint32_t failures = consecutive_failures_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (policy_.recovery_threshold != 0 && failures >= policy_.recovery_threshold)
+        {
+            recover_bus();
+        }
+    }
+
+    void INTERFACE::recover_bus()
+    {
+        consecutive_failures_.store(0, std::memory_order_relaxed);
+        if (recovery_hook_ == nullptr)
+            return;
+
+        const int64_t start_us = esp_timer_get_time();
+        esp_err_t err = recovery_hook_(i2c, recovery_ctx_);
+        const uint32_t duration_us = static_cast<uint32_t>(esp_timer_get_time() - start_us);
+
+        recoveries_.fetch_add(1, std::memory_order_relaxed);
+        recovery_time_us_.fetch_add(duration_us, std::memory_order_relaxed);
+        if (err != ESP_OK)
+        {
+            recovery_failures_.fetch_add(1, std::memory_order_relaxed);
+            ESP_LOGE(TAG, "Bus recovery failed (err=0x%x, %lu us)", err, static_cast<unsigned long>(duration_us));
+        }
+        else
+        {
+            ESP_LOGW(TAG, "Bus recovered in %lu us", static_cast<unsigned long>(duration_us));
+        }
+    }
+
+    void INTERFACE::backoff_wait(uint32_t delay_us)
+    {
+        // Attente active sous la milliseconde, sinon on rend la main au scheduler
+        if (delay_us < 1000)
+        {
+            esp_rom_delay_us(delay_us);
+            return;
+        }
+        TickType_t ticks = pdMS_TO_TICKS((delay_us + 999) / 1000);
+        vTaskDelay(ticks > 0 ? ticks : 1);
+    }
+
+    BusRecoveryCounters INTERFACE::bus_recovery_counters()
+    {
+        BusRecoveryCounters c;
+        c.failures = failures_.load(std::memory_order_relaxed);
+        c.retries = retries_.load(std::memory_order_relaxed);
+        c.deadline_misses = deadline_misses_.load(std::memory_order_relaxed);
+        c.recoveries = recoveries_.load(std::memory_order_relaxed);
+        c.recovery_failures = recovery_failures_.load(std::memory_order_relaxed);
+        c.recovery_time_us = recovery_time_us_.load(std::memory_order_relaxed);
+        return c;
+    }
+
+    void INTERFACE::reset_bus_recovery_counters()
+    {
+        failures_.store(0, std::memory_order_relaxed);
+        retries_.store(0, std::memory_order_relaxed);
+        deadline_misses_.store(0, std::memory_order_relaxed);
+        recoveries_.store(0, std::memory_order_relaxed);
+        recovery_failures_.store(0, std::memory_order_relaxed);
+        recovery_time_us_.store(0, std::memory_order_relaxed);
+    }
+
+} // namespace bq2579x
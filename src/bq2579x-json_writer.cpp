@@ -0,0 +1,128 @@
+#include "bq2579x-json_writer.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace bq2579x
+{
+    JsonWriter::JsonWriter(char *buffer, size_t capacity)
+        : buffer_(buffer),
+          capacity_(capacity)
+    {
+        if (buffer_ != nullptr && capacity_ > 0)
+            buffer_[0] = '\0';
+    }
+
+    JsonWriter::JsonWriter(Sink sink, void *ctx)
+        : sink_(sink),
+          ctx_(ctx)
+    {
+    }
+
+    JsonWriter &JsonWriter::raw(const char *text)
+    {
+        return raw(text, std::strlen(text));
+    }
+
+    JsonWriter &JsonWriter::raw(const char *text, size_t len)
+    {
+        if (sink_ != nullptr)
+        {
+            sink_(text, len, ctx_);
+        }
+        else if (buffer_ != nullptr && written_ + 1 < capacity_)
+        {
+            const size_t room = capacity_ - 1 - written_;
+            const size_t n = len < room ? len : room;
+            std::memcpy(buffer_ + written_, text, n);
+            buffer_[written_ + n] = '\0';
+        }
+        written_ += len;
+        return *this;
+    }
+
+    JsonWriter &JsonWriter::null()
+    {
+        return raw("null", 4);
+    }
+
+    JsonWriter &JsonWriter::unsigned_value(unsigned long long v, bool negative)
+    {
+        char digits[24];
+        size_t pos = sizeof(digits);
+        do
+        {
+            digits[--pos] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v != 0);
+        if (negative)
+            digits[--pos] = '-';
+        return raw(digits + pos, sizeof(digits) - pos);
+    }
+
+    JsonWriter &JsonWriter::value(int v) { return value(static_cast<long long>(v)); }
+    JsonWriter &JsonWriter::value(long v) { return value(static_cast<long long>(v)); }
+    JsonWriter &JsonWriter::value(unsigned v) { return unsigned_value(v, false); }
+    JsonWriter &JsonWriter::value(unsigned long v) { return unsigned_value(v, false); }
+    JsonWriter &JsonWriter::value(unsigned long long v) { return unsigned_value(v, false); }
+
+    JsonWriter &JsonWriter::value(long long v)
+    {
+        // Magnitude calculée en non signé : pas de débordement pour LLONG_MIN
+        const unsigned long long magnitude = v < 0 ? 0ULL - static_cast<unsigned long long>(v)
+                                                   : static_cast<unsigned long long>(v);
+        return unsigned_value(magnitude, v < 0);
+    }
+
+    JsonWriter &JsonWriter::printf_value(double v)
+    {
+        // Hors plage du chemin rapide (|v| >= 4e9, inf, nan) : 309 chiffres au plus
+        char text[320];
+        int n = std::snprintf(text, sizeof(text), "%f", v);
+        return raw(text, n > 0 ? static_cast<size_t>(n) : 0);
+    }
+
+    JsonWriter &JsonWriter::value(float v)
+    {
+        return value(static_cast<double>(v));
+    }
+
+    JsonWriter &JsonWriter::value(double v)
+    {
+        // Équivalent de "%f" (std::to_string) : 6 décimales, arrondi correct au plus
+        // proche pair. hi + lo est le produit exact v * 1e6 (1e6 est représentable).
+        const double hi = v * 1e6;
+        if (!std::isfinite(v) || std::fabs(hi) >= 4.0e15)
+            return printf_value(v);
+
+        const double lo = std::fma(v, 1e6, -hi);
+        double units_d = std::floor(hi);
+        const double rest = hi - units_d;
+        if (rest > 0.5 || (rest == 0.5 && (lo > 0.0 || (lo == 0.0 && std::fmod(units_d, 2.0) != 0.0))))
+            units_d += 1.0;
+
+        const long long units = static_cast<long long>(units_d);
+        const unsigned long long magnitude = units < 0 ? 0ULL - static_cast<unsigned long long>(units)
+                                                       : static_cast<unsigned long long>(units);
+        if (std::signbit(v))
+            raw("-", 1);
+        unsigned_value(magnitude / 1000000ULL, false);
+
+        char fraction[8];
+        unsigned long long frac = magnitude % 1000000ULL;
+        fraction[0] = '.';
+        for (int i = 6; i >= 1; --i)
+        {
+            fraction[i] = static_cast<char>('0' + frac % 10);
+            frac /= 10;
+        }
+        return raw(fraction, 7);
+    }
+
+    void JsonWriter::stdout_sink(const char *data, size_t len, void *)
+    {
+        std::fwrite(data, 1, len, stdout);
+    }
+
+} // namespace bq2579x
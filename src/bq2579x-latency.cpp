@@ -0,0 +1,39 @@
+#include "bq2579x-latency.hpp"
+
+namespace bq2579x
+{
+    void LatencyHistogram::add(uint32_t ns)
+    {
+        count++;
+        total_ns += ns;
+        if (ns < min_ns)
+            min_ns = ns;
+        if (ns > max_ns)
+            max_ns = ns;
+
+        uint32_t us = ns / 1000;
+        size_t bucket = 0;
+        while (us != 0 && bucket < BUCKETS - 1)
+        {
+            us >>= 1;
+            bucket++;
+        }
+        buckets[bucket]++;
+    }
+
+    uint32_t LatencyHistogram::percentile_us(uint8_t pct) const
+    {
+        if (count == 0)
+            return 0;
+        const uint64_t target = (static_cast<uint64_t>(count) * pct + 99) / 100;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i)
+        {
+            seen += buckets[i];
+            if (seen >= target && seen != 0)
+                return i < BUCKETS - 1 ? (1u << i) : max_ns / 1000;
+        }
+        return max_ns / 1000;
+    }
+
+} // namespace bq2579x
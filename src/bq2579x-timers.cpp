@@ -0,0 +1,59 @@
+#include "bq2579x-timers.hpp"
+
+namespace bq2579x
+{
+    void TIMER_WHEEL::arm(size_t slot, int64_t deadline_us)
+    {
+        if (slot < MAX_TIMERS)
+            deadline_us_[slot] = deadline_us;
+    }
+
+    void TIMER_WHEEL::cancel(size_t slot)
+    {
+        arm(slot, NEVER);
+    }
+
+    bool TIMER_WHEEL::armed(size_t slot) const
+    {
+        return slot < MAX_TIMERS && deadline_us_[slot] != NEVER;
+    }
+
+    bool TIMER_WHEEL::advance(size_t slot, uint32_t period_us, int64_t now_us)
+    {
+        if (slot >= MAX_TIMERS)
+            return false;
+        int64_t next = fired_us_[slot] + period_us;
+        const bool on_time = next > now_us;
+        if (!on_time)
+            next = now_us;
+        deadline_us_[slot] = next;
+        return on_time;
+    }
+
+    int64_t TIMER_WHEEL::next_deadline_us() const
+    {
+        int64_t next = NEVER;
+        for (int64_t d : deadline_us_)
+        {
+            if (d < next)
+                next = d;
+        }
+        return next;
+    }
+
+    uint32_t TIMER_WHEEL::fire(int64_t now_us)
+    {
+        uint32_t due = 0;
+        for (size_t i = 0; i < MAX_TIMERS; ++i)
+        {
+            if (deadline_us_[i] != NEVER && deadline_us_[i] <= now_us)
+            {
+                fired_us_[i] = deadline_us_[i];
+                deadline_us_[i] = NEVER;
+                due |= 1u << i;
+            }
+        }
+        return due;
+    }
+
+} // namespace bq2579x
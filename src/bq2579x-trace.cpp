@@ -0,0 +1,50 @@
+#include "bq2579x-trace.hpp"
+
+#ifdef CONFIG_BQ25798_TRACE
+
+#include "esp_log.h"
+
+namespace bq2579x
+{
+    size_t TRACE::snapshot(TraceEntry *out, size_t max_entries)
+    {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        const size_t available = head < DEPTH ? head : DEPTH;
+        const size_t count = available < max_entries ? available : max_entries;
+        const uint32_t first = head - count;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = ring_[(first + i) % DEPTH];
+        }
+        return count;
+    }
+
+    void TRACE::dump()
+    {
+        // Lecture directe du ring : pas de copie de DEPTH entrées sur la pile
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        const size_t count = head < DEPTH ? head : DEPTH;
+        const uint32_t first = head - count;
+
+        ESP_LOGI(TAG, "%u transaction(s) enregistrée(s)", static_cast<unsigned>(count));
+        for (size_t i = 0; i < count; ++i)
+        {
+            const TraceEntry e = ring_[(first + i) % DEPTH];
+            ESP_LOGI(TAG, "[%10lu us] %s Reg: 0x%02X | Len: %u | %s",
+                     static_cast<unsigned long>(e.timestamp_us),
+                     e.dir == TraceDirection::Read ? "READ " : "WRITE",
+                     e.reg,
+                     e.len,
+                     esp_err_to_name(e.err));
+        }
+    }
+
+    void TRACE::clear()
+    {
+        head_.store(0, std::memory_order_relaxed);
+    }
+
+} // namespace bq2579x
+
+#endif
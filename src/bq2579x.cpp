@@ -2,6 +2,7 @@
 //#include "config/bq2579x-config_types.hpp"
 #include "bq2579x.hpp"
 #include "sdkconfig.h"
+#include "esp_timer.h"
 
 #define RETURN_IF_ERROR(x)         \
     do {                           \
@@ -11,7 +12,7 @@
         }                          \
     } while (0)
 
-#define HANDLE_OUTPUT(format, obj)                            \
+#define HANDLE_OUTPUT(format, obj, with_adc)                  \
     do {                                                      \
         switch (format)                                       \
         {                                                     \
@@ -19,7 +20,14 @@
                 obj.log();                                    \
                 break;                                        \
             case OutputFormat::JSON:                          \
-                printf("%s\n", obj.to_json().c_str());        \
+            {                                                 \
+                JsonWriter w(JsonWriter::stdout_sink, nullptr); \
+                obj.write_json(w);                            \
+                w.raw("\n");                                  \
+                break;                                        \
+            }                                                 \
+            case OutputFormat::Binary:                        \
+                RETURN_IF_ERROR(emit_telemetry(with_adc));    \
                 break;                                        \
             case OutputFormat::None:                          \
             default:                                          \
@@ -44,21 +52,33 @@ namespace bq2579x
     BQ2579XManager::BQ2579XManager(I2CDevices &i2c)
         : i2c_(i2c),
           cfg_(i2c_),
-          alert_gpio_(gpio_num_t(CONFIG_BQ25798_ALERT_GPIO)),
+          alert_gpio_(CONFIG_BQ25798_ALERT_GPIO),
           status_(i2c_),
-          ctrl_(i2c_)
-          {}
+          ctrl_(i2c_),
+          async_(i2c_),
+          stream_ctrl_(i2c_)
+    {
+        loop_ack_ = xSemaphoreCreateBinaryStatic(&loop_ack_buf_);
+        stream_control_lock_ = xSemaphoreCreateMutexStatic(&stream_control_lock_buf_);
+        state_lock_ = xSemaphoreCreateRecursiveMutexStatic(&state_lock_buf_);
+    }
 
     // === API PUBLIQUE ===
 
     void BQ2579XManager::init()
     {
+        esp_err_t err = async_.start();
+        if (err != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Échec du démarrage de la tâche du bus : %s", esp_err_to_name(err));
+        }
         xTaskCreatePinnedToCore(task_wrapper, "STUSB_Task", 4096, this, 5, &task_handle_, 0);
     }
 
     esp_err_t BQ2579XManager::init_device()
     {
         RETURN_IF_ERROR(is_ready());
+        StateLock lock(*this);
         //ConfigParams from_kconfig = load_config_from_kconfig();
         //cfg_.datas() = from_kconfig ; 
 
@@ -69,6 +89,13 @@ namespace bq2579x
         //from_kconfig.log();
         RETURN_IF_ERROR(get_status());
         RETURN_IF_ERROR(apply_config(cfg_));
+#ifdef CONFIG_BQ25798_ADC_ADAPTIVE
+        adaptive_adc_ = true;
+#endif
+        if (adaptive_adc_)
+        {
+            RETURN_IF_ERROR(apply_adc_schedule(true));
+        }
         return ESP_OK;
     }
 
@@ -102,15 +129,147 @@ namespace bq2579x
     esp_err_t BQ2579XManager::apply_config(Config &cfg)
     {   
         RETURN_IF_ERROR(return_if_not_ready(ready_, TAG));
+        StateLock lock(*this);
         ESP_LOGI(TAG, "Set config");
-        return cfg.set();   
+        const size_t span = flags_span(cfg.datas().mask);
+        RETURN_IF_ERROR(discard_unread_flags(span));
+        RETURN_IF_ERROR(cfg.set());
+        flags_span_ = span;
+
+        // Les voies désactivées ne sont plus lues : plan de rafales dérivé de la configuration
+        const uint16_t channels = cfg.datas().adc.enabled_channels();
+        ctrl_.set_adc_channels(channels);
+        // stream_ctrl_ appartient à la boucle, qui peut être au milieu d'une lecture : elle
+        // reprend le plan entre deux échantillons
+        stream_adc_channels_.store(channels);
+        if (task_handle_ == nullptr)
+            stream_ctrl_.set_adc_channels(channels);
+        else
+            post_loop_request(REQUEST_ADC_PLAN, false);
+        return ESP_OK;
     }
 
     esp_err_t BQ2579XManager::handle_alert()
     {
         RETURN_IF_ERROR(return_if_not_ready(ready_, TAG));
-        RETURN_IF_ERROR(status_.get_flags());
+        ChargerEventMessage msg;
+        RETURN_IF_ERROR(read_alert(msg));
+        // Hors verrou : un abonné peut rappeler l'API du gestionnaire
+        events_.dispatch(msg);
+        return ESP_OK;
+    }
+
+    esp_err_t BQ2579XManager::read_alert(ChargerEventMessage &msg)
+    {
+        StateLock lock(*this);
+        // Statuts + flags dans la même transaction : les flags effacés à la lecture
+        // et les bits de statut décrivent le même instant
+        RETURN_IF_ERROR(status_.get_snapshot(alert_flags_span()));
 
+        // Expiration du watchdog : le composant est revenu aux valeurs par défaut, la configuration
+        // est réécrite ici, dans la boucle, comme au retour du contrôle de santé
+        if (status_.charger_flag0.get_values().wd_flag)
+        {
+            ESP_LOGW(TAG, "Watchdog expiré, configuration réécrite");
+            cfg_.invalidate_cache();
+            esp_err_t err = apply_config(cfg_);
+            if (err != ESP_OK)
+            {
+                ESP_LOGW(TAG, "Réécriture de la configuration impossible : %s", esp_err_to_name(err));
+            }
+        }
+
+        if (adaptive_adc_)
+        {
+            esp_err_t err = apply_adc_schedule(false);
+            if (err != ESP_OK)
+            {
+                ESP_LOGW(TAG, "Mode ADC non appliqué : %s", esp_err_to_name(err));
+            }
+        }
+
+        // Flags décodés une fois ici : les abonnés ne relisent jamais le bus
+        msg.timestamp_us = esp_timer_get_time();
+        msg.events = decode_events(status_);
+#ifdef CONFIG_BQ25798_ALERT_LATENCY
+        if (alert_isr_pending_)
+        {
+            record_alert_latency(alert_latency_.isr_to_flags, alert_isr_cycles_);
+            alert_isr_pending_ = false;
+        }
+#endif
+#ifdef CONFIG_BQ25798_ALERT_STORM_GUARD
+        // Source trop bavarde : masquée le temps du back-off (démasquage dans task_main)
+        const uint64_t storm = alert_guard_.record(msg.events, msg.timestamp_us);
+        if (storm != 0)
+        {
+            esp_err_t err = set_event_masks(storm, true);
+            if (err != ESP_OK)
+            {
+                alert_guard_.rollback(storm, 0, msg.timestamp_us);
+                ESP_LOGW(TAG, "Masquage des sources d'alerte impossible : %s", esp_err_to_name(err));
+            }
+        }
+#endif
+        msg.status[0] = status_.charger_status0.get_raw();
+        msg.status[1] = status_.charger_status1.get_raw();
+        msg.status[2] = status_.charger_status2.get_raw();
+        msg.status[3] = status_.charger_status3.get_raw();
+        msg.status[4] = status_.charger_status4.get_raw();
+        msg.status[5] = status_.fault_status0.get_raw();
+        msg.status[6] = status_.fault_status1.get_raw();
+        return ESP_OK;
+    }
+
+    esp_err_t BQ2579XManager::set_adc_policy(const ADCPolicyRule *rules, size_t count, const ADCSchedule &fallback)
+    {
+        StateLock lock(*this);
+        RETURN_IF_ERROR(adc_scheduler_.set_policy(rules, count, fallback));
+        return adaptive_adc_ ? apply_adc_schedule(false) : ESP_OK;
+    }
+
+    esp_err_t BQ2579XManager::set_adaptive_adc(bool enable)
+    {
+        StateLock lock(*this);
+        adaptive_adc_ = enable;
+        if (!enable)
+            return ESP_OK;
+        RETURN_IF_ERROR(return_if_not_ready(ready_, TAG));
+        RETURN_IF_ERROR(status_.get_status());
+        return apply_adc_schedule(true);
+    }
+
+    ADCSchedule BQ2579XManager::current_adc_schedule() const
+    {
+        StateLock lock(*this);
+        return adc_schedule_;
+    }
+
+    esp_err_t BQ2579XManager::apply_adc_schedule(bool force)
+    {
+        ChargerStatus1Register::Values st = status_.charger_status1.get_values();
+        const ADCSchedule &schedule = adc_scheduler_.select(st.charge_status, st.vbus_status);
+        if (!force && adc_schedule_applied_ && schedule == adc_schedule_)
+            return ESP_OK;
+
+        // One-shot : ADC_EN reste à 0, chaque acquisition lance sa conversion
+        ConfigADC &adc = cfg_.datas().adc;
+        ADCControlRegister::Values v = adc.acd.get_values();
+        v.adc_enable = !schedule.oneshot;
+        v.adc_rate_oneshot = schedule.oneshot;
+        v.sample_resolution = schedule.resolution;
+        adc.acd.set_values(v);
+        RETURN_IF_ERROR(cfg_.set_adc_control_register());
+
+        adc_schedule_ = schedule;
+        adc_schedule_applied_ = true;
+        stream_oneshot_us_.store(schedule.oneshot ? adc.conversion_time_us() : 0);
+        stream_period_ms_.store(schedule.period_ms);
+        ESP_LOGI(TAG, "Mode ADC : %s, %d bits, %lu ms (%s / %s)",
+                 schedule.oneshot ? "one-shot" : "continu",
+                 15 - static_cast<int>(schedule.resolution),
+                 static_cast<unsigned long>(schedule.period_ms),
+                 to_string(st.charge_status), to_string(st.vbus_status));
         return ESP_OK;
     }
 
@@ -126,24 +285,505 @@ namespace bq2579x
     esp_err_t BQ2579XManager::get_status(OutputFormat format)
     {
         RETURN_IF_ERROR(return_if_not_ready(ready_, TAG));
+        StateLock lock(*this);
         RETURN_IF_ERROR(status_.get_status());
-        HANDLE_OUTPUT(format, status_);
+        // Trame binaire : statuts seuls, les résultats ADC de ctrl_ datent d'une autre lecture
+        HANDLE_OUTPUT(format, status_, false);
         return ESP_OK;
     }
 
     esp_err_t BQ2579XManager::get_measurements(OutputFormat format)
     {
-        auto status = cfg_.datas().adc.acd.get_values();
-        if (status.adc_rate_oneshot == true ) {
-            RETURN_IF_ERROR(ctrl_.en_adc());
-            vTaskDelay(50);
-        }
         RETURN_IF_ERROR(return_if_not_ready(ready_, TAG));
+        uint32_t oneshot_us = 0;
+        {
+            StateLock lock(*this);
+            const ConfigADC &adc = cfg_.datas().adc;
+            if (adc.acd.get_values().adc_rate_oneshot)
+                oneshot_us = adc.conversion_time_us();
+        }
+        if (oneshot_us != 0)
+        {
+            // Réveil sur ADC_DONE : durée attendue selon la résolution et les voies actives ;
+            // attente hors verrou, la boucle sert les alertes pendant la conversion
+            RETURN_IF_ERROR(ctrl_.convert_oneshot(oneshot_us, 2 * oneshot_us + ADC_TIMEOUT_MARGIN_US));
+        }
+        // Plan de lecture de ctrl_ et statuts : modifiés par apply_config() et les alertes
+        StateLock lock(*this);
         RETURN_IF_ERROR(ctrl_.get());
-        HANDLE_OUTPUT(format, ctrl_);
+#if defined(CONFIG_BQ25798_ADC_STATS) || defined(CONFIG_BQ25798_ENERGY)
+        ADCSample sample;
+        sample.timestamp_us = esp_timer_get_time();
+        ctrl_.to_sample(sample);
+#ifdef CONFIG_BQ25798_ADC_STATS
+        adc_stats_.add(sample);
+#endif
+#ifdef CONFIG_BQ25798_ENERGY
+        // Pendant le streaming, le compteur suit les échantillons de la boucle du gestionnaire seuls
+        if (!streaming())
+        {
+            energy_.add(sample);
+            energy_.save_if_pending();
+        }
+#endif
+#endif
+        if (format == OutputFormat::Binary)
+        {
+            // La trame porte aussi les statuts : les relire pour qu'ils datent de la mesure
+            RETURN_IF_ERROR(status_.get_status());
+        }
+        HANDLE_OUTPUT(format, ctrl_, true);
         return ESP_OK;
     }
 
+    esp_err_t BQ2579XManager::set_adc_rate_groups(const ADCRateGroup *groups, size_t count)
+    {
+#ifdef CONFIG_BQ25798_RATE_GROUPS
+        return rate_groups_.set_groups(groups, count);
+#else
+        // Le streaming lit toutes les voies à chaque tour : des groupes seraient ignorés
+        (void)groups;
+        (void)count;
+        return ESP_ERR_NOT_SUPPORTED;
+#endif
+    }
+
+    esp_err_t BQ2579XManager::start_streaming(uint32_t period_ms)
+    {
+        RETURN_IF_ERROR(return_if_not_ready(ready_, TAG));
+        if (task_handle_ == nullptr)
+            return ESP_ERR_INVALID_STATE;
+        if (period_ms == 0)
+            return ESP_ERR_INVALID_ARG;
+        StreamControlLock guard(*this);
+        if (stream_active_.load())
+            return ESP_ERR_INVALID_STATE;
+
+        StateLock lock(*this);
+        ADCControlRegister &acd = cfg_.datas().adc.acd;
+        stream_saved_adc_control_ = acd.get_raw();
+        if (adaptive_adc_)
+        {
+            // Mode et période suivent l'état de charge (apply_adc_schedule)
+            RETURN_IF_ERROR(apply_adc_schedule(true));
+        }
+        else
+        {
+            // Conversion continue : chaque lecture rend la dernière conversion terminée,
+            // la tâche n'attend jamais la fin d'un one-shot
+            ADCControlRegister::Values v = acd.get_values();
+            v.adc_enable = true;
+            v.adc_rate_oneshot = false;
+            acd.set_values(v);
+            RETURN_IF_ERROR(cfg_.set_adc_control_register());
+            stream_oneshot_us_.store(0);
+            stream_period_ms_.store(period_ms);
+        }
+
+        portENTER_CRITICAL(&stream_stats_lock_);
+        stream_stats_ = {};
+        portEXIT_CRITICAL(&stream_stats_lock_);
+#ifdef CONFIG_BQ25798_RATE_GROUPS
+        rate_groups_.restart();
+#endif
+        // Échantillonnage cadencé par la boucle de la tâche du gestionnaire
+        stream_active_.store(true);
+        post_loop_request(REQUEST_STREAM_START, false);
+        ESP_LOGI(TAG, "Streaming ADC démarré (%lu ms)", static_cast<unsigned long>(stream_period_ms_.load()));
+        return ESP_OK;
+    }
+
+    void BQ2579XManager::stop_streaming()
+    {
+        // Un seul demandeur à la fois : un second stop attend que le premier soit acquitté
+        StreamControlLock guard(*this);
+        if (!stream_active_.exchange(false))
+            return;
+
+        // Retour une fois la lecture en cours terminée : plus aucun accès du streaming ensuite
+        post_loop_request(REQUEST_STREAM_STOP, true);
+
+        StateLock lock(*this);
+        if (adaptive_adc_)
+            return; // le mode ADC reste celui de l'ordonnanceur
+
+        cfg_.datas().adc.acd.set_raw(stream_saved_adc_control_);
+        esp_err_t err = cfg_.set_adc_control_register();
+        if (err != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Restauration du mode ADC impossible : %s", esp_err_to_name(err));
+        }
+    }
+
+    StreamStats BQ2579XManager::get_stream_stats() const
+    {
+        portENTER_CRITICAL(&stream_stats_lock_);
+        StreamStats copy = stream_stats_;
+        portEXIT_CRITICAL(&stream_stats_lock_);
+        return copy;
+    }
+
+    void BQ2579XManager::stream_step()
+    {
+        // Période et mode relus à chaque tour : l'ordonnanceur ADC peut les changer
+        const uint32_t period_ms = stream_period_ms_.load();
+        const uint32_t oneshot_us = stream_oneshot_us_.load();
+        const int64_t now_us = esp_timer_get_time();
+        esp_err_t err = ESP_OK;
+
+        // One-shot : la conversion se termine pendant que la boucle sert les alertes,
+        // la case TIMER_STREAM sert d'échéance de sondage d'ADC_DONE_STAT
+        if (oneshot_us != 0 && !stream_converting_)
+        {
+            stream_sample_us_ = now_us;
+            err = stream_ctrl_.en_adc();
+            if (err == ESP_OK)
+            {
+                stream_converting_ = true;
+                timers_.arm(TIMER_STREAM, now_us + oneshot_us);
+                return;
+            }
+        }
+        else if (stream_converting_)
+        {
+            bool done = false;
+            err = stream_ctrl_.adc_done(done);
+            if (err == ESP_OK && !done)
+            {
+                if (now_us < stream_sample_us_ + 2 * static_cast<int64_t>(oneshot_us) + ADC_TIMEOUT_MARGIN_US)
+                {
+                    timers_.arm(TIMER_STREAM, now_us + CTRL::ADC_POLL_US);
+                    return;
+                }
+                ESP_LOGW(TAG, "Conversion ADC non terminée après %lu us",
+                         static_cast<unsigned long>(now_us - stream_sample_us_));
+                err = ESP_ERR_TIMEOUT;
+            }
+            stream_converting_ = false;
+        }
+        else
+        {
+            stream_sample_us_ = now_us;
+        }
+
+        ADCSample sample;
+        sample.timestamp_us = stream_sample_us_;
+        if (err == ESP_OK)
+        {
+#ifdef CONFIG_BQ25798_RATE_GROUPS
+            // Groupes échus dans la demi-période : lus dans cette rafale plutôt qu'au tour suivant
+            err = stream_ctrl_.get_adc(rate_groups_.due(sample.timestamp_us, period_ms * 500));
+#else
+            err = stream_ctrl_.get_adc();
+#endif
+        }
+        uint32_t read_us = static_cast<uint32_t>(esp_timer_get_time() - sample.timestamp_us);
+
+        if (err == ESP_OK)
+        {
+            stream_ctrl_.to_sample(sample);
+#ifdef CONFIG_BQ25798_ENERGY
+            // Intégration sur les valeurs brutes : elle moyenne déjà
+            energy_.add(sample);
+            // Écriture du stockage (flash...) dans sa propre case : pas dans la période d'échantillonnage
+            if (energy_.save_pending())
+                timers_.arm(TIMER_SAVE, esp_timer_get_time());
+#endif
+#ifdef CONFIG_BQ25798_ADC_STATS
+            // Même entrée que get_measurements() : valeurs brutes, pas les sorties maintenues d'un CIC
+            adc_stats_.add(sample);
+#endif
+#ifdef CONFIG_BQ25798_FILTER
+            filters_.apply(sample);
+#endif
+            stream_ring_.push(sample);
+        }
+
+        portENTER_CRITICAL(&stream_stats_lock_);
+        if (err == ESP_OK)
+            stream_stats_.samples++;
+        else
+            stream_stats_.read_errors++;
+        stream_stats_.last_read_us = read_us;
+        if (read_us > stream_stats_.max_read_us)
+            stream_stats_.max_read_us = read_us;
+        if (read_us > period_ms * 1000)
+            stream_stats_.late_periods++;
+        portEXIT_CRITICAL(&stream_stats_lock_);
+
+        // Prochaine période sans dérive depuis le début de celle-ci ; une lecture trop longue
+        // recale l'échéance sur maintenant
+        stream_due_us_ += static_cast<int64_t>(period_ms ? period_ms : 1) * 1000;
+        const int64_t end_us = esp_timer_get_time();
+        if (stream_due_us_ < end_us)
+            stream_due_us_ = end_us;
+        timers_.arm(TIMER_STREAM, stream_due_us_);
+    }
+
+    void BQ2579XManager::set_telemetry_sink(TelemetrySink sink, void *ctx)
+    {
+        telemetry_sink_ = sink;
+        telemetry_ctx_ = ctx;
+    }
+
+    void BQ2579XManager::build_telemetry_frame(TelemetryFrame &frame, bool with_adc)
+    {
+        StateLock lock(*this);
+        frame.sequence = telemetry_sequence_++;
+        frame.ico_raw = ctrl_.ico_current_limit_ma.get_raw();
+
+        const ADCSnapshot &adc = ctrl_.adc_snapshot();
+        // Horodatage de l'acquisition ADC ; sans ADC, celui de la construction (statuts juste lus)
+        frame.timestamp_us = static_cast<uint64_t>(with_adc ? adc.timestamp_us : esp_timer_get_time());
+        for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+            frame.adc_raw[i] = adc.raw[i];
+        frame.adc_valid = with_adc ? adc.valid : 0;
+        for (size_t i = 0; i < TelemetryFrame::ADC_COUNT; ++i)
+        {
+            if (!(frame.adc_valid & (1u << i)))
+                frame.adc_raw[i] = 0;
+        }
+
+        frame.status[0] = status_.charger_status0.get_raw();
+        frame.status[1] = status_.charger_status1.get_raw();
+        frame.status[2] = status_.charger_status2.get_raw();
+        frame.status[3] = status_.charger_status3.get_raw();
+        frame.status[4] = status_.charger_status4.get_raw();
+        frame.status[5] = status_.fault_status0.get_raw();
+        frame.status[6] = status_.fault_status1.get_raw();
+    }
+
+    esp_err_t BQ2579XManager::emit_telemetry(bool with_adc)
+    {
+        if (telemetry_sink_ == nullptr)
+        {
+            ESP_LOGW(TAG, "Aucune destination pour la trame binaire (set_telemetry_sink)");
+            return ESP_ERR_INVALID_STATE;
+        }
+
+        TelemetryFrame frame;
+        build_telemetry_frame(frame, with_adc);
+        uint8_t buffer[TelemetryFrame::SIZE];
+        size_t len = frame.encode(buffer, sizeof(buffer));
+        telemetry_sink_(buffer, len, telemetry_ctx_);
+        return ESP_OK;
+    }
+
+    void BQ2579XManager::set_retry_policy(const RetryPolicy &policy)
+    {
+        StateLock lock(*this);
+        cfg_.set_retry_policy(policy);
+        status_.set_retry_policy(policy);
+        ctrl_.set_retry_policy(policy);
+        stream_ctrl_.set_retry_policy(policy);
+        async_.set_retry_policy(policy);
+    }
+
+    void BQ2579XManager::set_bus_recovery(BusRecoveryHook hook, void *ctx)
+    {
+        INTERFACE::set_bus_recovery(hook, ctx);
+    }
+
+    BusRecoveryCounters BQ2579XManager::get_bus_recovery_counters() const
+    {
+        return INTERFACE::bus_recovery_counters();
+    }
+
+    void BQ2579XManager::reset_bus_recovery_counters()
+    {
+        INTERFACE::reset_bus_recovery_counters();
+    }
+
+    esp_err_t BQ2579XManager::get_bus_stats(BusStatsSnapshot &out) const
+    {
+#ifdef CONFIG_BQ25798_BUS_STATS
+        BUS_STATS::snapshot(out);
+        return ESP_OK;
+#else
+        out = {};
+        return ESP_ERR_NOT_SUPPORTED;
+#endif
+    }
+
+    void BQ2579XManager::reset_bus_stats()
+    {
+#ifdef CONFIG_BQ25798_BUS_STATS
+        BUS_STATS::reset();
+#endif
+    }
+
+    void BQ2579XManager::dump_trace() const
+    {
+#ifdef CONFIG_BQ25798_TRACE
+        TRACE::dump();
+#else
+        ESP_LOGW(TAG, "Trace I2C désactivée (CONFIG_BQ25798_TRACE)");
+#endif
+    }
+
+    namespace
+    {
+        // Registres de masque dans l'ordre des registres de flags (REG28h..REG2Dh)
+        uint8_t get_mask_raw(const ConfigMask &m, size_t reg)
+        {
+            switch (reg)
+            {
+            case 0: return m.charger_mask.charger_mask0.get_raw();
+            case 1: return m.charger_mask.charger_mask1.get_raw();
+            case 2: return m.charger_mask.charger_mask2.get_raw();
+            case 3: return m.charger_mask.charger_mask3.get_raw();
+            case 4: return m.fault_mask.fault_mask0.get_raw();
+            default: return m.fault_mask.fault_mask1.get_raw();
+            }
+        }
+
+        void set_mask_raw(ConfigMask &m, size_t reg, uint8_t raw)
+        {
+            switch (reg)
+            {
+            case 0: m.charger_mask.charger_mask0.set_raw(raw); break;
+            case 1: m.charger_mask.charger_mask1.set_raw(raw); break;
+            case 2: m.charger_mask.charger_mask2.set_raw(raw); break;
+            case 3: m.charger_mask.charger_mask3.set_raw(raw); break;
+            case 4: m.fault_mask.fault_mask0.set_raw(raw); break;
+            default: m.fault_mask.fault_mask1.set_raw(raw); break;
+            }
+        }
+    }
+
+    size_t BQ2579XManager::flags_span(const ConfigMask &m)
+    {
+        // Les registres de flags dont toutes les sources sont masquées en fin de bloc ne sont pas lus
+        uint8_t masks[STATUS::FLAGS_BLOCK_LEN];
+        for (size_t reg = 0; reg < STATUS::FLAGS_BLOCK_LEN; ++reg)
+            masks[reg] = get_mask_raw(m, reg);
+        return unmasked_flags_span(masks);
+    }
+
+    size_t BQ2579XManager::alert_flags_span()
+    {
+        return flags_span_;
+    }
+
+    esp_err_t BQ2579XManager::discard_unread_flags(size_t span)
+    {
+        // Registres hors de la fenêtre lue jusqu'ici : leurs flags sont levés depuis le masquage,
+        // les effacer avant de démasquer pour que la prochaine alerte ne les serve pas comme neufs
+        if (span <= flags_span_)
+            return ESP_OK;
+        return status_.discard_flags(flags_span_, span);
+    }
+
+    esp_err_t BQ2579XManager::set_event_masks(uint64_t events, bool masked)
+    {
+        static esp_err_t (Config::*const WRITE[STATUS::FLAGS_BLOCK_LEN])() = {
+            &Config::set_charger_mask_0_register, &Config::set_charger_mask_1_register,
+            &Config::set_charger_mask_2_register, &Config::set_charger_mask_3_register,
+            &Config::set_fault_mask_0_register, &Config::set_fault_mask_1_register};
+
+        ConfigMask &m = cfg_.datas().mask;
+        const ConfigMask saved = m;
+        uint64_t owned = storm_masked_;
+        uint8_t touched = 0;
+        for (size_t i = 0; i < static_cast<size_t>(ChargerEvent::COUNT); ++i)
+        {
+            const uint64_t bit = 1ULL << i;
+            size_t reg;
+            uint8_t pos;
+            if (!(events & bit) || !event_flag_bit(static_cast<ChargerEvent>(i), reg, pos))
+                continue;
+
+            uint8_t raw = get_mask_raw(m, reg);
+            if (masked)
+            {
+                // Bit déjà masqué par la configuration : il lui appartient, ne pas le relâcher ensuite
+                if ((raw & (1u << pos)) && !(owned & bit))
+                    continue;
+                raw |= static_cast<uint8_t>(1u << pos);
+                owned |= bit;
+            }
+            else
+            {
+                if (!(owned & bit))
+                    continue;
+                raw &= static_cast<uint8_t>(~(1u << pos));
+                owned &= ~bit;
+            }
+            set_mask_raw(m, reg, raw);
+            touched |= static_cast<uint8_t>(1u << reg);
+        }
+
+        const size_t span = flags_span(m);
+        esp_err_t err = discard_unread_flags(span);
+        for (size_t reg = 0; err == ESP_OK && reg < STATUS::FLAGS_BLOCK_LEN; ++reg)
+        {
+            if (touched & (1u << reg))
+                err = (cfg_.*WRITE[reg])();
+        }
+        if (err != ESP_OK)
+        {
+            // Copie locale restaurée : une nouvelle tentative réécrira tous les registres concernés
+            m = saved;
+            return err;
+        }
+        flags_span_ = span;
+        storm_masked_ = owned;
+        return ESP_OK;
+    }
+
+    void BQ2579XManager::service_storm_unmask()
+    {
+        const int64_t now_us = esp_timer_get_time();
+        const uint64_t expired = alert_guard_.expired(now_us);
+        if (expired != 0)
+        {
+            StateLock lock(*this);
+            esp_err_t err = set_event_masks(expired, false);
+            if (err != ESP_OK)
+            {
+                alert_guard_.rollback(0, expired, now_us);
+                ESP_LOGW(TAG, "Démasquage des sources d'alerte impossible : %s", esp_err_to_name(err));
+            }
+        }
+        timers_.arm(TIMER_UNMASK, alert_guard_.next_unmask_us());
+    }
+
+    void BQ2579XManager::set_storm_protection(uint32_t min_interval_ms, uint16_t threshold, uint32_t backoff_ms)
+    {
+        alert_guard_.configure(min_interval_ms, threshold, 1000, backoff_ms);
+    }
+
+    StormStats BQ2579XManager::get_storm_stats() const
+    {
+        return alert_guard_.stats();
+    }
+
+    void BQ2579XManager::record_alert_latency(LatencyHistogram &hist, uint32_t isr_cycles)
+    {
+        // Différence modulo 2^32 : exacte tant que la latence reste sous ~17 s à 240 MHz
+        const uint32_t cycles = port::cycle_count() - isr_cycles;
+        const uint32_t mhz = port::cycles_per_us();
+        const uint64_t ns = mhz ? static_cast<uint64_t>(cycles) * 1000 / mhz : 0;
+        portENTER_CRITICAL(&alert_latency_lock_);
+        hist.add(ns > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(ns));
+        portEXIT_CRITICAL(&alert_latency_lock_);
+    }
+
+    AlertLatency BQ2579XManager::get_alert_latency() const
+    {
+        portENTER_CRITICAL(&alert_latency_lock_);
+        AlertLatency copy = alert_latency_;
+        portEXIT_CRITICAL(&alert_latency_lock_);
+        return copy;
+    }
+
+    void BQ2579XManager::reset_alert_latency()
+    {
+        portENTER_CRITICAL(&alert_latency_lock_);
+        alert_latency_ = {};
+        portEXIT_CRITICAL(&alert_latency_lock_);
+    }
+
     void BQ2579XManager::task_wrapper(void *arg)
     {
         static_cast<BQ2579XManager *>(arg)->task_main();
@@ -153,51 +793,186 @@ namespace bq2579x
     {
         auto *self = static_cast<BQ2579XManager *>(arg);
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-        vTaskNotifyGiveFromISR(self->task_handle_, &xHigherPriorityTaskWoken);
+        // Horodatage au cycle CPU (ISR et tâche sur le cœur 0), publié avant l'alerte
+        self->alert_isr_stamp_.store(port::cycle_count());
+        self->alert_pending_.store(true);
+        xTaskNotifyFromISR(self->task_handle_, 0, eNoAction, &xHigherPriorityTaskWoken);
         portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
     }
 
-    void BQ2579XManager::setup_interrupt(gpio_num_t gpio)
+    void BQ2579XManager::setup_interrupt(int gpio)
     {
-        static bool isr_installed = false;
-        gpio_config_t io_conf = {};
-        io_conf.intr_type = GPIO_INTR_NEGEDGE;
-        io_conf.mode = GPIO_MODE_INPUT;
-        io_conf.pin_bit_mask = (1ULL << gpio);
-        io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
-        gpio_config(&io_conf);
+        esp_err_t err = port::alert_attach(gpio, gpio_isr_handler, this);
+        if (err != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Failed to attach INT handler: %s", esp_err_to_name(err));
+        }
+    }
 
-        if (!isr_installed)
+    void BQ2579XManager::post_loop_request(uint32_t request, bool wait)
+    {
+        if (xTaskGetCurrentTaskHandle() == task_handle_)
         {
-            esp_err_t err = gpio_install_isr_service(ESP_INTR_FLAG_LEVEL3);
-            if (err == ESP_OK || err == ESP_ERR_INVALID_STATE)
-            {
-                isr_installed = true;
-            }
-            else
-            {
-                ESP_LOGE(TAG, "Failed to install ISR service: %s", esp_err_to_name(err));
-            }
+            // Appel depuis la boucle elle-même (rappel d'abonné) : traité sur place
+            loop_requests_.fetch_or(request);
+            run_loop_requests();
+            return;
+        }
+        // Sémaphore dédié : la notification de l'appelant reste libre (ASYNC_INTERFACE l'utilise)
+        if (wait)
+            loop_ack_wanted_.store(true);
+        loop_requests_.fetch_or(request);
+        xTaskNotify(task_handle_, 0, eNoAction);
+        if (wait)
+            xSemaphoreTake(loop_ack_, portMAX_DELAY);
+    }
+
+    void BQ2579XManager::run_loop_requests()
+    {
+        const uint32_t requests = loop_requests_.exchange(0);
+        if (requests & REQUEST_ADC_PLAN)
+            stream_ctrl_.set_adc_channels(stream_adc_channels_.load());
+        if (requests & REQUEST_STREAM_START)
+        {
+            stream_due_us_ = esp_timer_get_time();
+            stream_converting_ = false;
+            timers_.arm(TIMER_STREAM, stream_due_us_);
+        }
+        if (requests & REQUEST_STREAM_STOP)
+        {
+            // Une conversion one-shot en cours se termine seule ; son résultat est ignoré
+            timers_.cancel(TIMER_STREAM);
+            stream_converting_ = false;
+            if (loop_ack_wanted_.exchange(false))
+                xSemaphoreGive(loop_ack_);
+        }
+    }
+
+    void BQ2579XManager::on_alert(uint32_t isr_cycles)
+    {
+#ifdef CONFIG_BQ25798_ALERT_LATENCY
+        // Ligne vue basse au démarrage, sans notification : pas d'horodatage ISR pour cette alerte
+        alert_isr_pending_ = isr_cycles != 0;
+        alert_isr_cycles_ = isr_cycles;
+        if (alert_isr_pending_)
+            record_alert_latency(alert_latency_.isr_to_wakeup, isr_cycles);
+#endif
+#ifdef CONFIG_BQ25798_ALERT_STORM_GUARD
+        // Intervalle minimal entre deux services : les flags s'accumulent dans le composant
+        // et les alertes arrivées entre-temps sont servies par la même lecture
+        if (alert_deferred_)
+        {
+            alert_guard_.note_coalesced();
+            return;
+        }
+        const int64_t now_us = esp_timer_get_time();
+        const int64_t delay_us = alert_guard_.service_delay_us(now_us);
+        if (delay_us > 0)
+        {
+            alert_deferred_ = true;
+            timers_.arm(TIMER_ALERT, now_us + delay_us);
+            return;
+        }
+#endif
+        service_alert();
+    }
+
+    void BQ2579XManager::service_alert()
+    {
+        alert_deferred_ = false;
+        ESP_LOGE(TAG, "Alert");
+        handle_alert();
+#ifdef CONFIG_BQ25798_ALERT_STORM_GUARD
+        timers_.arm(TIMER_UNMASK, alert_guard_.next_unmask_us());
+#endif
+    }
+
+    void BQ2579XManager::health_check()
+    {
+        const bool ok = ctrl_.ready() == ESP_OK;
+        if (ok == healthy_.load())
+            return;
+
+        healthy_.store(ok);
+        if (!ok)
+        {
+            ESP_LOGW(TAG, "BQ2579X ne répond plus");
+            return;
+        }
+        // Retour du composant : il a pu redémarrer avec ses valeurs par défaut
+        ESP_LOGI(TAG, "BQ2579X de nouveau présent, configuration réécrite");
+        StateLock lock(*this);
+        cfg_.invalidate_cache();
+        esp_err_t err = apply_config(cfg_);
+        if (err != ESP_OK)
+        {
+            ESP_LOGW(TAG, "Réécriture de la configuration impossible : %s", esp_err_to_name(err));
         }
+    }
 
-        gpio_isr_handler_add(gpio, gpio_isr_handler, this);
+    TickType_t BQ2579XManager::loop_wait_ticks() const
+    {
+        const int64_t next_us = timers_.next_deadline_us();
+        if (next_us == TIMER_WHEEL::NEVER)
+            return portMAX_DELAY;
+        const int64_t wait_us = next_us - esp_timer_get_time();
+        if (wait_us <= 0)
+            return 0;
+        const TickType_t ticks = pdMS_TO_TICKS((wait_us + 999) / 1000);
+        return ticks ? ticks : 1;
     }
 
     void BQ2579XManager::task_main()
     {
         setup_interrupt(alert_gpio_);
         init_device();
-        
+
+        // INT est une impulsion : seul un niveau bas antérieur à l'installation de l'ISR est lu ici
+        if (port::alert_line_low(alert_gpio_))
+            alert_pending_.store(true);
+
+        const int64_t start_us = esp_timer_get_time();
+        if (CONFIG_BQ25798_WATCHDOG_KICK_MS > 0)
+            timers_.arm(TIMER_WATCHDOG, start_us + CONFIG_BQ25798_WATCHDOG_KICK_MS * 1000LL);
+        if (CONFIG_BQ25798_HEALTH_PERIOD_MS > 0)
+            timers_.arm(TIMER_HEALTH, start_us + CONFIG_BQ25798_HEALTH_PERIOD_MS * 1000LL);
+
+        // Une seule attente : interruption, demande d'une autre tâche ou prochaine échéance
         while (true)
         {
-            if (gpio_get_level(alert_gpio_) == 0 || ulTaskNotifyTake(pdTRUE, portMAX_DELAY))
+            xTaskNotifyWait(0, UINT32_MAX, nullptr, loop_wait_ticks());
+
+            if (loop_requests_.load() != 0)
+                run_loop_requests();
+            // Horodatage repris après l'alerte : une ISR survenue entre les deux relance simplement
+            // un tour, sans laisser d'horodatage périmé pour l'alerte suivante
+            if (alert_pending_.exchange(false))
+                on_alert(alert_isr_stamp_.exchange(0));
+
+            const uint32_t due = timers_.fire(esp_timer_get_time());
+            if (due & (1u << TIMER_ALERT))
+                service_alert();
+            if (due & (1u << TIMER_UNMASK))
+                service_storm_unmask();
+            if (due & (1u << TIMER_STREAM))
+                stream_step();
+#ifdef CONFIG_BQ25798_ENERGY
+            if (due & (1u << TIMER_SAVE))
+                energy_.save_if_pending();
+#endif
+            if (due & (1u << TIMER_WATCHDOG))
             {
-                if (gpio_get_level(alert_gpio_) == 0)
+                esp_err_t err = ctrl_.send_reset();
+                if (err != ESP_OK)
                 {
-                    ESP_LOGE(TAG, "Alert");
-                    handle_alert();
+                    ESP_LOGW(TAG, "Rafraîchissement du watchdog impossible : %s", esp_err_to_name(err));
                 }
-                
+                timers_.advance(TIMER_WATCHDOG, CONFIG_BQ25798_WATCHDOG_KICK_MS * 1000, esp_timer_get_time());
+            }
+            if (due & (1u << TIMER_HEALTH))
+            {
+                health_check();
+                timers_.advance(TIMER_HEALTH, CONFIG_BQ25798_HEALTH_PERIOD_MS * 1000, esp_timer_get_time());
             }
         }
     }
@@ -22,10 +22,118 @@ namespace bq2579x
           params_(params)
     {
     }
+
+    void Config::cache_store(uint8_t reg, const uint8_t *data, size_t len)
+    {
+        for (size_t i = 0; i < len && reg + i < REG_COUNT; ++i)
+        {
+            shadow_[reg + i] = data[i];
+            known_.set(reg + i);
+            dirty_.reset(reg + i);
+        }
+    }
+
+    void Config::invalidate_cache()
+    {
+        known_.reset();
+    }
+
+    void Config::mark_dirty(uint8_t reg)
+    {
+        if (reg < REG_COUNT)
+            dirty_.set(reg);
+    }
+
+    esp_err_t Config::load_u8(uint8_t reg, uint8_t &out)
+    {
+        RETURN_IF_ERROR(read_u8(reg, out));
+        cache_store(reg, &out, 1);
+        return ESP_OK;
+    }
+
+    esp_err_t Config::load_u16(uint8_t reg, uint16_t &out)
+    {
+        RETURN_IF_ERROR(read_u16(reg, out));
+        const uint8_t raw[2] = {static_cast<uint8_t>(out >> 8), static_cast<uint8_t>(out & 0xFF)};
+        cache_store(reg, raw, 2);
+        return ESP_OK;
+    }
+
+    esp_err_t Config::store_u8(uint8_t reg, uint8_t value)
+    {
+        RETURN_IF_ERROR(write_u8(reg, value));
+        cache_store(reg, &value, 1);
+        return ESP_OK;
+    }
+
+    esp_err_t Config::store_u16(uint8_t reg, uint16_t value)
+    {
+        RETURN_IF_ERROR(write_u16(reg, value));
+        const uint8_t raw[2] = {static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value & 0xFF)};
+        cache_store(reg, raw, 2);
+        return ESP_OK;
+    }
+
+    void Config::build_image(uint8_t *image, RegisterSet &present, RegisterSet &word_lsb) const
+    {
+        auto put_u8 = [&](uint8_t reg, uint8_t raw)
+        {
+            image[reg] = raw;
+            present.set(reg);
+        };
+        auto put_u16 = [&](uint8_t reg, uint16_t raw)
+        {
+            // Big Endian : MSB à l'adresse du registre, LSB à l'adresse suivante
+            image[reg] = (raw >> 8) & 0xFF;
+            image[reg + 1] = raw & 0xFF;
+            present.set(reg);
+            present.set(reg + 1);
+            word_lsb.set(reg + 1);
+        };
+
+        const ConfigLimit &limit = params_.limit;
+        put_u8(limit.vsysmin_mv.reg_addr, limit.vsysmin_mv.get_raw());
+        put_u16(limit.vreg_mv.reg_addr, limit.vreg_mv.get_raw());
+        put_u16(limit.ichg_ma.reg_addr, limit.ichg_ma.get_raw());
+        put_u8(limit.vindpm_mv.reg_addr, limit.vindpm_mv.get_raw());
+        put_u16(limit.iindpm_ma.reg_addr, limit.iindpm_ma.get_raw());
+        put_u16(limit.votg_mv.reg_addr, limit.votg_mv.get_raw());
+        put_u8(limit.iotg_values.reg_addr, limit.iotg_values.get_raw());
+
+        const ConfigControl &control = params_.control;
+        put_u8(control.pre_charge.reg_addr, control.pre_charge.get_raw());
+        put_u8(control.termination.reg_addr, control.termination.get_raw());
+        put_u8(control.re_charge.reg_addr, control.re_charge.get_raw());
+        put_u8(control.timer.reg_addr, control.timer.get_raw());
+        put_u8(control.charger.charger_control0.reg_addr, control.charger.charger_control0.get_raw());
+        put_u8(control.charger.charger_control1.reg_addr, control.charger.charger_control1.get_raw());
+        put_u8(control.charger.charger_control2.reg_addr, control.charger.charger_control2.get_raw());
+        put_u8(control.charger.charger_control3.reg_addr, control.charger.charger_control3.get_raw());
+        put_u8(control.charger.charger_control4.reg_addr, control.charger.charger_control4.get_raw());
+        put_u8(control.charger.charger_control5.reg_addr, control.charger.charger_control5.get_raw());
+        put_u8(control.mppt.reg_addr, control.mppt.get_raw());
+        put_u8(control.temperature.reg_addr, control.temperature.get_raw());
+        put_u8(control.ntc.ntc_control0.reg_addr, control.ntc.ntc_control0.get_raw());
+        put_u8(control.ntc.ntc_control1.reg_addr, control.ntc.ntc_control1.get_raw());
+        put_u8(control.dpdm.reg_addr, control.dpdm.get_raw());
+
+        const ConfigMask &mask = params_.mask;
+        put_u8(mask.charger_mask.charger_mask0.reg_addr, mask.charger_mask.charger_mask0.get_raw());
+        put_u8(mask.charger_mask.charger_mask1.reg_addr, mask.charger_mask.charger_mask1.get_raw());
+        put_u8(mask.charger_mask.charger_mask2.reg_addr, mask.charger_mask.charger_mask2.get_raw());
+        put_u8(mask.charger_mask.charger_mask3.reg_addr, mask.charger_mask.charger_mask3.get_raw());
+        put_u8(mask.fault_mask.fault_mask0.reg_addr, mask.fault_mask.fault_mask0.get_raw());
+        put_u8(mask.fault_mask.fault_mask1.reg_addr, mask.fault_mask.fault_mask1.get_raw());
+
+        const ConfigADC &adc = params_.adc;
+        put_u8(adc.acd.reg_addr, adc.acd.get_raw());
+        put_u8(adc.adc_function_disable.adc_function_disable0.reg_addr, adc.adc_function_disable.adc_function_disable0.get_raw());
+        put_u8(adc.adc_function_disable.adc_function_disable1.reg_addr, adc.adc_function_disable.adc_function_disable1.get_raw());
+    }
     esp_err_t Config::get_minimal_system_voltage()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.limit.vsysmin_mv.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.limit.vsysmin_mv.reg_addr, raw));
         params_.limit.vsysmin_mv.set_raw(raw);
         return ESP_OK;
     }
@@ -33,14 +141,14 @@ namespace bq2579x
     esp_err_t Config::set_minimal_system_voltage()
     {
         uint8_t raw = params_.limit.vsysmin_mv.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.limit.vsysmin_mv.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.limit.vsysmin_mv.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charge_voltage_limit_register()
     {
         uint16_t raw = 0;
-        RETURN_IF_ERROR(read_u16(params_.limit.vreg_mv.reg_addr, raw));
+        RETURN_IF_ERROR(load_u16(params_.limit.vreg_mv.reg_addr, raw));
         params_.limit.vreg_mv.set_raw(raw);
         return ESP_OK;
     }
@@ -48,14 +156,14 @@ namespace bq2579x
     esp_err_t Config::set_charge_voltage_limit_register()
     {
         uint16_t raw = params_.limit.vreg_mv.get_raw();
-        RETURN_IF_ERROR(write_u16(params_.limit.vreg_mv.reg_addr, raw));
+        RETURN_IF_ERROR(store_u16(params_.limit.vreg_mv.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charge_current_limit_register()
     {
         uint16_t raw = 0;
-        RETURN_IF_ERROR(read_u16(params_.limit.ichg_ma.reg_addr, raw));
+        RETURN_IF_ERROR(load_u16(params_.limit.ichg_ma.reg_addr, raw));
         params_.limit.ichg_ma.set_raw(raw);
         return ESP_OK;
     }
@@ -63,14 +171,14 @@ namespace bq2579x
     esp_err_t Config::set_charge_current_limit_register()
     {
         uint16_t raw = params_.limit.ichg_ma.get_raw();
-        RETURN_IF_ERROR(write_u16(params_.limit.ichg_ma.reg_addr, raw));
+        RETURN_IF_ERROR(store_u16(params_.limit.ichg_ma.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_input_voltage_limit_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.limit.vindpm_mv.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.limit.vindpm_mv.reg_addr, raw));
         params_.limit.vindpm_mv.set_raw(raw);
         return ESP_OK;
     }
@@ -78,14 +186,14 @@ namespace bq2579x
     esp_err_t Config::set_input_voltage_limit_register()
     {
         uint8_t raw = params_.limit.vindpm_mv.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.limit.vindpm_mv.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.limit.vindpm_mv.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_input_current_limit_register()
     {
         uint16_t raw = 0;
-        RETURN_IF_ERROR(read_u16(params_.limit.iindpm_ma.reg_addr, raw));
+        RETURN_IF_ERROR(load_u16(params_.limit.iindpm_ma.reg_addr, raw));
         params_.limit.iindpm_ma.set_raw(raw);
         return ESP_OK;
     }
@@ -93,14 +201,14 @@ namespace bq2579x
     esp_err_t Config::set_input_current_limit_register()
     {
         uint16_t raw = params_.limit.iindpm_ma.get_raw();
-        RETURN_IF_ERROR(write_u16(params_.limit.iindpm_ma.reg_addr, raw));
+        RETURN_IF_ERROR(store_u16(params_.limit.iindpm_ma.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_votg_regulation_register()
     {
         uint16_t raw = 0;
-        RETURN_IF_ERROR(read_u16(params_.limit.votg_mv.reg_addr, raw));
+        RETURN_IF_ERROR(load_u16(params_.limit.votg_mv.reg_addr, raw));
         params_.limit.votg_mv.set_raw(raw);
         return ESP_OK;
     }
@@ -108,14 +216,14 @@ namespace bq2579x
     esp_err_t Config::set_votg_regulation_register()
     {
         uint16_t raw = params_.limit.votg_mv.get_raw();
-        RETURN_IF_ERROR(write_u16(params_.limit.votg_mv.reg_addr, raw));
+        RETURN_IF_ERROR(store_u16(params_.limit.votg_mv.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_iotg_regulation_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.limit.iotg_values.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.limit.iotg_values.reg_addr, raw));
         params_.limit.iotg_values.set_raw(raw);
         return ESP_OK;
     }
@@ -123,14 +231,14 @@ namespace bq2579x
     esp_err_t Config::set_iotg_regulation_register()
     {
         uint8_t raw = params_.limit.iotg_values.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.limit.iotg_values.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.limit.iotg_values.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_precharge_control_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.pre_charge.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.pre_charge.reg_addr, raw));
         params_.control.pre_charge.set_raw(raw);
         return ESP_OK;
     }
@@ -138,14 +246,14 @@ namespace bq2579x
     esp_err_t Config::set_precharge_control_register()
     {
         uint8_t raw = params_.control.pre_charge.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.pre_charge.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.pre_charge.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_termination_control_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.termination.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.termination.reg_addr, raw));
         params_.control.termination.set_raw(raw);
         return ESP_OK;
     }
@@ -153,14 +261,14 @@ namespace bq2579x
     esp_err_t Config::set_termination_control_register()
     {
         uint8_t raw = params_.control.termination.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.termination.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.termination.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_recharge_control_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.re_charge.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.re_charge.reg_addr, raw));
         params_.control.re_charge.set_raw(raw);
         return ESP_OK;
     }
@@ -168,14 +276,14 @@ namespace bq2579x
     esp_err_t Config::set_recharge_control_register()
     {
         uint8_t raw = params_.control.re_charge.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.re_charge.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.re_charge.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_timer_control_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.timer.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.timer.reg_addr, raw));
         params_.control.timer.set_raw(raw);
         return ESP_OK;
     }
@@ -183,14 +291,14 @@ namespace bq2579x
     esp_err_t Config::set_timer_control_register()
     {
         uint8_t raw = params_.control.timer.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.timer.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.timer.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charger_control_0_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.charger.charger_control0.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.charger.charger_control0.reg_addr, raw));
         params_.control.charger.charger_control0.set_raw(raw);
         return ESP_OK;
     }
@@ -198,14 +306,14 @@ namespace bq2579x
     esp_err_t Config::set_charger_control_0_register()
     {
         uint8_t raw = params_.control.charger.charger_control0.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.charger.charger_control0.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.charger.charger_control0.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charger_control_1_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.charger.charger_control1.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.charger.charger_control1.reg_addr, raw));
         params_.control.charger.charger_control1.set_raw(raw);
         return ESP_OK;
     }
@@ -213,14 +321,14 @@ namespace bq2579x
     esp_err_t Config::set_charger_control_1_register()
     {
         uint8_t raw = params_.control.charger.charger_control1.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.charger.charger_control1.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.charger.charger_control1.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charger_control_2_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.charger.charger_control2.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.charger.charger_control2.reg_addr, raw));
         params_.control.charger.charger_control2.set_raw(raw);
         return ESP_OK;
     }
@@ -228,14 +336,14 @@ namespace bq2579x
     esp_err_t Config::set_charger_control_2_register()
     {
         uint8_t raw = params_.control.charger.charger_control2.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.charger.charger_control2.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.charger.charger_control2.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charger_control_3_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.charger.charger_control3.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.charger.charger_control3.reg_addr, raw));
         params_.control.charger.charger_control3.set_raw(raw);
         return ESP_OK;
     }
@@ -243,14 +351,14 @@ namespace bq2579x
     esp_err_t Config::set_charger_control_3_register()
     {
         uint8_t raw = params_.control.charger.charger_control3.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.charger.charger_control3.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.charger.charger_control3.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charger_control_4_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.charger.charger_control4.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.charger.charger_control4.reg_addr, raw));
         params_.control.charger.charger_control4.set_raw(raw);
         return ESP_OK;
     }
@@ -258,14 +366,14 @@ namespace bq2579x
     esp_err_t Config::set_charger_control_4_register()
     {
         uint8_t raw = params_.control.charger.charger_control4.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.charger.charger_control4.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.charger.charger_control4.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charger_control_5_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.charger.charger_control5.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.charger.charger_control5.reg_addr, raw));
         params_.control.charger.charger_control5.set_raw(raw);
         return ESP_OK;
     }
@@ -273,14 +381,14 @@ namespace bq2579x
     esp_err_t Config::set_charger_control_5_register()
     {
         uint8_t raw = params_.control.charger.charger_control5.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.charger.charger_control5.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.charger.charger_control5.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_mppt_control_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.mppt.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.mppt.reg_addr, raw));
         params_.control.mppt.set_raw(raw);
         return ESP_OK;
     }
@@ -288,14 +396,14 @@ namespace bq2579x
     esp_err_t Config::set_mppt_control_register()
     {
         uint8_t raw = params_.control.mppt.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.mppt.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.mppt.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_temperature_control_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.temperature.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.temperature.reg_addr, raw));
         params_.control.temperature.set_raw(raw);
         return ESP_OK;
     }
@@ -303,14 +411,14 @@ namespace bq2579x
     esp_err_t Config::set_temperature_control_register()
     {
         uint8_t raw = params_.control.temperature.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.temperature.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.temperature.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_ntc_control_0_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.ntc.ntc_control0.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.ntc.ntc_control0.reg_addr, raw));
         params_.control.ntc.ntc_control0.set_raw(raw);
         return ESP_OK;
     }
@@ -318,14 +426,14 @@ namespace bq2579x
     esp_err_t Config::set_ntc_control_0_register()
     {
         uint8_t raw = params_.control.ntc.ntc_control0.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.ntc.ntc_control0.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.ntc.ntc_control0.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_ntc_control_1_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.ntc.ntc_control1.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.ntc.ntc_control1.reg_addr, raw));
         params_.control.ntc.ntc_control1.set_raw(raw);
         return ESP_OK;
     }
@@ -333,14 +441,14 @@ namespace bq2579x
     esp_err_t Config::set_ntc_control_1_register()
     {
         uint8_t raw = params_.control.ntc.ntc_control1.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.ntc.ntc_control1.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.ntc.ntc_control1.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charger_mask_0_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.mask.charger_mask.charger_mask0.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.mask.charger_mask.charger_mask0.reg_addr, raw));
         params_.mask.charger_mask.charger_mask0.set_raw(raw);
         return ESP_OK;
     }
@@ -348,14 +456,14 @@ namespace bq2579x
     esp_err_t Config::set_charger_mask_0_register()
     {
         uint8_t raw = params_.mask.charger_mask.charger_mask0.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.mask.charger_mask.charger_mask0.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.mask.charger_mask.charger_mask0.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charger_mask_1_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.mask.charger_mask.charger_mask1.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.mask.charger_mask.charger_mask1.reg_addr, raw));
         params_.mask.charger_mask.charger_mask1.set_raw(raw);
         return ESP_OK;
     }
@@ -363,14 +471,14 @@ namespace bq2579x
     esp_err_t Config::set_charger_mask_1_register()
     {
         uint8_t raw = params_.mask.charger_mask.charger_mask1.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.mask.charger_mask.charger_mask1.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.mask.charger_mask.charger_mask1.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charger_mask_2_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.mask.charger_mask.charger_mask2.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.mask.charger_mask.charger_mask2.reg_addr, raw));
         params_.mask.charger_mask.charger_mask2.set_raw(raw);
         return ESP_OK;
     }
@@ -378,14 +486,14 @@ namespace bq2579x
     esp_err_t Config::set_charger_mask_2_register()
     {
         uint8_t raw = params_.mask.charger_mask.charger_mask2.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.mask.charger_mask.charger_mask2.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.mask.charger_mask.charger_mask2.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_charger_mask_3_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.mask.charger_mask.charger_mask3.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.mask.charger_mask.charger_mask3.reg_addr, raw));
         params_.mask.charger_mask.charger_mask3.set_raw(raw);
         return ESP_OK;
     }
@@ -393,14 +501,14 @@ namespace bq2579x
     esp_err_t Config::set_charger_mask_3_register()
     {
         uint8_t raw = params_.mask.charger_mask.charger_mask3.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.mask.charger_mask.charger_mask3.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.mask.charger_mask.charger_mask3.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_fault_mask_0_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.mask.fault_mask.fault_mask0.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.mask.fault_mask.fault_mask0.reg_addr, raw));
         params_.mask.fault_mask.fault_mask0.set_raw(raw);
         return ESP_OK;
     }
@@ -408,14 +516,14 @@ namespace bq2579x
     esp_err_t Config::set_fault_mask_0_register()
     {
         uint8_t raw = params_.mask.fault_mask.fault_mask0.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.mask.fault_mask.fault_mask0.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.mask.fault_mask.fault_mask0.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_fault_mask_1_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.mask.fault_mask.fault_mask1.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.mask.fault_mask.fault_mask1.reg_addr, raw));
         params_.mask.fault_mask.fault_mask1.set_raw(raw);
         return ESP_OK;
     }
@@ -423,14 +531,14 @@ namespace bq2579x
     esp_err_t Config::set_fault_mask_1_register()
     {
         uint8_t raw = params_.mask.fault_mask.fault_mask1.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.mask.fault_mask.fault_mask1.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.mask.fault_mask.fault_mask1.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_adc_control_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.adc.acd.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.adc.acd.reg_addr, raw));
         params_.adc.acd.set_raw(raw);
         return ESP_OK;
     }
@@ -438,14 +546,14 @@ namespace bq2579x
     esp_err_t Config::set_adc_control_register()
     {
         uint8_t raw = params_.adc.acd.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.adc.acd.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.adc.acd.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_adc_function_disable_0_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.adc.adc_function_disable.adc_function_disable0.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.adc.adc_function_disable.adc_function_disable0.reg_addr, raw));
         params_.adc.adc_function_disable.adc_function_disable0.set_raw(raw);
         return ESP_OK;
     }
@@ -453,14 +561,14 @@ namespace bq2579x
     esp_err_t Config::set_adc_function_disable_0_register()
     {
         uint8_t raw = params_.adc.adc_function_disable.adc_function_disable0.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.adc.adc_function_disable.adc_function_disable0.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.adc.adc_function_disable.adc_function_disable0.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_adc_function_disable_1_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.adc.adc_function_disable.adc_function_disable1.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.adc.adc_function_disable.adc_function_disable1.reg_addr, raw));
         params_.adc.adc_function_disable.adc_function_disable1.set_raw(raw);
         return ESP_OK;
     }
@@ -468,14 +576,14 @@ namespace bq2579x
     esp_err_t Config::set_adc_function_disable_1_register()
     {
         uint8_t raw = params_.adc.adc_function_disable.adc_function_disable1.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.adc.adc_function_disable.adc_function_disable1.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.adc.adc_function_disable.adc_function_disable1.reg_addr, raw));
         return ESP_OK;
     }
 
     esp_err_t Config::get_dpdm_driver_register()
     {
         uint8_t raw = 0;
-        RETURN_IF_ERROR(read_u8(params_.control.dpdm.reg_addr, raw));
+        RETURN_IF_ERROR(load_u8(params_.control.dpdm.reg_addr, raw));
         params_.control.dpdm.set_raw(raw);
         return ESP_OK;
     }
@@ -483,7 +591,7 @@ namespace bq2579x
     esp_err_t Config::set_dpdm_driver_register()
     {
         uint8_t raw = params_.control.dpdm.get_raw();
-        RETURN_IF_ERROR(write_u8(params_.control.dpdm.reg_addr, raw));
+        RETURN_IF_ERROR(store_u8(params_.control.dpdm.reg_addr, raw));
         return ESP_OK;
     }
 
@@ -600,10 +708,46 @@ namespace bq2579x
 
     esp_err_t Config::set()
     {
-        RETURN_IF_ERROR(set_limit_registers());
-        RETURN_IF_ERROR(set_control_registers());
-        RETURN_IF_ERROR(set_mask_registers());
-        RETURN_IF_ERROR(set_adc_registers());
+        uint8_t image[REG_COUNT] = {};
+        RegisterSet present;
+        RegisterSet word_lsb;
+        build_image(image, present, word_lsb);
+
+        for (size_t reg = 0; reg < REG_COUNT; ++reg)
+        {
+            if (present.test(reg) && (!known_.test(reg) || shadow_[reg] != image[reg]))
+                dirty_.set(reg);
+        }
+        dirty_ &= present;
+
+        // Un registre 16 bits est toujours écrit en entier (MSB + LSB)
+        for (size_t reg = 1; reg < REG_COUNT; ++reg)
+        {
+            if (word_lsb.test(reg) && (dirty_.test(reg) || dirty_.test(reg - 1)))
+            {
+                dirty_.set(reg - 1);
+                dirty_.set(reg);
+            }
+        }
+
+        // Les registres sales voisins sont fusionnés en une écriture auto-incrémentée
+        size_t reg = 0;
+        while (reg < REG_COUNT)
+        {
+            if (!dirty_.test(reg))
+            {
+                ++reg;
+                continue;
+            }
+            size_t end = reg;
+            while (end + 1 < REG_COUNT && dirty_.test(end + 1))
+                ++end;
+
+            const size_t len = end - reg + 1;
+            RETURN_IF_ERROR(write_register(static_cast<uint8_t>(reg), &image[reg], len));
+            cache_store(static_cast<uint8_t>(reg), &image[reg], len);
+            reg = end + 1;
+        }
         return ESP_OK;
     }
 
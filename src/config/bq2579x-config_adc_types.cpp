@@ -48,17 +48,27 @@ namespace bq2579x
                  v.average_init);
     }
 
-    std::string ADCControlRegister::to_json() const
+    void ADCControlRegister::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"EN\": " + std::to_string(v.adc_enable) + "," +
-               "\"OS\": " + std::to_string(v.adc_rate_oneshot) + "," +
-               "\"RES\": " + std::to_string(static_cast<uint8_t>(v.sample_resolution)) + "," +
-               "\"AVG_EN\": " + std::to_string(v.average_enable) + "," +
-               "\"AVG_INIT\": " + std::to_string(v.average_init) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"EN\": ")
+            .value(v.adc_enable)
+            .raw(",\"OS\": ")
+            .value(v.adc_rate_oneshot)
+            .raw(",\"RES\": ")
+            .value(static_cast<uint8_t>(v.sample_resolution))
+            .raw(",\"AVG_EN\": ")
+            .value(v.average_enable)
+            .raw(",\"AVG_INIT\": ")
+            .value(v.average_init)
+            .raw("}");
+    }
+
+    std::string ADCControlRegister::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void ADCFunctionDisable0Register::set_values(const ADCFunctionDisable0Register::Values &v)
@@ -94,19 +104,31 @@ namespace bq2579x
                  v.tdie_adc_disable);
     }
 
-    std::string ADCFunctionDisable0Register::to_json() const
+    void ADCFunctionDisable0Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"IBUS\": " + std::to_string(v.ibus_adc_disable) + "," +
-               "\"IBAT\": " + std::to_string(v.ibat_adc_disable) + "," +
-               "\"VBUS\": " + std::to_string(v.vbus_adc_disable) + "," +
-               "\"VBAT\": " + std::to_string(v.vbat_adc_disable) + "," +
-               "\"VSYS\": " + std::to_string(v.vsys_adc_disable) + "," +
-               "\"TS\": " + std::to_string(v.ts_adc_disable) + "," +
-               "\"TDIE\": " + std::to_string(v.tdie_adc_disable) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"IBUS\": ")
+            .value(v.ibus_adc_disable)
+            .raw(",\"IBAT\": ")
+            .value(v.ibat_adc_disable)
+            .raw(",\"VBUS\": ")
+            .value(v.vbus_adc_disable)
+            .raw(",\"VBAT\": ")
+            .value(v.vbat_adc_disable)
+            .raw(",\"VSYS\": ")
+            .value(v.vsys_adc_disable)
+            .raw(",\"TS\": ")
+            .value(v.ts_adc_disable)
+            .raw(",\"TDIE\": ")
+            .value(v.tdie_adc_disable)
+            .raw("}");
+    }
+
+    std::string ADCFunctionDisable0Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void ADCFunctionDisable1Register::set_values(const ADCFunctionDisable1Register::Values &v)
@@ -136,16 +158,25 @@ namespace bq2579x
                  v.vac1_adc_disable);
     }
 
-    std::string ADCFunctionDisable1Register::to_json() const
+    void ADCFunctionDisable1Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"DP\": " + std::to_string(v.dp_adc_disable) + "," +
-               "\"DM\": " + std::to_string(v.dm_adc_disable) + "," +
-               "\"VAC2\": " + std::to_string(v.vac2_adc_disable) + "," +
-               "\"VAC1\": " + std::to_string(v.vac1_adc_disable) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"DP\": ")
+            .value(v.dp_adc_disable)
+            .raw(",\"DM\": ")
+            .value(v.dm_adc_disable)
+            .raw(",\"VAC2\": ")
+            .value(v.vac2_adc_disable)
+            .raw(",\"VAC1\": ")
+            .value(v.vac1_adc_disable)
+            .raw("}");
+    }
+
+    std::string ADCFunctionDisable1Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void ADCFunctionDisableRegister::log() const
@@ -154,12 +185,47 @@ namespace bq2579x
         adc_function_disable1.log();
     }
 
+    void ADCFunctionDisableRegister::write_json(JsonWriter &w) const
+    {
+        w.raw("{\"disable0\": ");
+        adc_function_disable0.write_json(w);
+        w.raw(",\"disable1\": ");
+        adc_function_disable1.write_json(w);
+        w.raw("}");
+    }
+
     std::string ADCFunctionDisableRegister::to_json() const
     {
-        return std::string("{") +
-               "\"disable0\": " + adc_function_disable0.to_json() + "," +
-               "\"disable1\": " + adc_function_disable1.to_json() +
-               "}";
+        return to_json_string(*this);
+    }
+
+    uint16_t ConfigADC::enabled_channels() const
+    {
+        ADCFunctionDisable0Register::Values d0 = adc_function_disable.adc_function_disable0.get_values();
+        ADCFunctionDisable1Register::Values d1 = adc_function_disable.adc_function_disable1.get_values();
+        uint16_t mask = 0;
+        mask |= d0.ibus_adc_disable ? 0 : adc_channel_bit(ADCChannel::IBUS);
+        mask |= d0.ibat_adc_disable ? 0 : adc_channel_bit(ADCChannel::IBAT);
+        mask |= d0.vbus_adc_disable ? 0 : adc_channel_bit(ADCChannel::VBUS);
+        mask |= d1.vac1_adc_disable ? 0 : adc_channel_bit(ADCChannel::VAC1);
+        mask |= d1.vac2_adc_disable ? 0 : adc_channel_bit(ADCChannel::VAC2);
+        mask |= d0.vbat_adc_disable ? 0 : adc_channel_bit(ADCChannel::VBAT);
+        mask |= d0.vsys_adc_disable ? 0 : adc_channel_bit(ADCChannel::VSYS);
+        mask |= d0.ts_adc_disable ? 0 : adc_channel_bit(ADCChannel::TS);
+        mask |= d0.tdie_adc_disable ? 0 : adc_channel_bit(ADCChannel::TDIE);
+        mask |= d1.dp_adc_disable ? 0 : adc_channel_bit(ADCChannel::DPLUS);
+        mask |= d1.dm_adc_disable ? 0 : adc_channel_bit(ADCChannel::DMINUS);
+        return mask;
+    }
+
+    uint8_t ConfigADC::enabled_channel_count() const
+    {
+        return static_cast<uint8_t>(__builtin_popcount(enabled_channels()));
+    }
+
+    uint32_t ConfigADC::conversion_time_us() const
+    {
+        return channel_conversion_time_us(acd.get_values().sample_resolution) * enabled_channel_count();
     }
 
     void ConfigADC::log() const
@@ -168,12 +234,18 @@ namespace bq2579x
         adc_function_disable.log();
     }
 
+    void ConfigADC::write_json(JsonWriter &w) const
+    {
+        w.raw("{\"control\": ");
+        acd.write_json(w);
+        w.raw(",\"function_disable\": ");
+        adc_function_disable.write_json(w);
+        w.raw("}");
+    }
+
     std::string ConfigADC::to_json() const
     {
-        return std::string("{") +
-               "\"control\": " + acd.to_json() + "," +
-               "\"function_disable\": " + adc_function_disable.to_json() +
-               "}";
+        return to_json_string(*this);
     }
 
 }
\ No newline at end of file
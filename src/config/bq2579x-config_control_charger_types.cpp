@@ -41,20 +41,33 @@ namespace bq2579x
         ESP_LOGI(TAG, " EN_BACKUP       : %d", v.en_backup);
     }
 
-    std::string ChargerControl0Register::to_json() const
+    void ChargerControl0Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"EN_AUTO_IBATDIS\": " + std::to_string(v.en_auto_ibatdis) + "," +
-               "\"FORCE_IBATDIS\": " + std::to_string(v.force_ibatdis) + "," +
-               "\"EN_CHG\": " + std::to_string(v.en_chg) + "," +
-               "\"EN_ICO\": " + std::to_string(v.en_ico) + "," +
-               "\"FORCE_ICO\": " + std::to_string(v.force_ico) + "," +
-               "\"EN_HIZ\": " + std::to_string(v.en_hiz) + "," +
-               "\"EN_TERM\": " + std::to_string(v.en_term) + "," +
-               "\"EN_BACKUP\": " + std::to_string(v.en_backup) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"EN_AUTO_IBATDIS\": ")
+            .value(v.en_auto_ibatdis)
+            .raw(",\"FORCE_IBATDIS\": ")
+            .value(v.force_ibatdis)
+            .raw(",\"EN_CHG\": ")
+            .value(v.en_chg)
+            .raw(",\"EN_ICO\": ")
+            .value(v.en_ico)
+            .raw(",\"FORCE_ICO\": ")
+            .value(v.force_ico)
+            .raw(",\"EN_HIZ\": ")
+            .value(v.en_hiz)
+            .raw(",\"EN_TERM\": ")
+            .value(v.en_term)
+            .raw(",\"EN_BACKUP\": ")
+            .value(v.en_backup)
+            .raw("}");
+    }
+
+    std::string ChargerControl0Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     ChargerControl1Register::Values ChargerControl1Register::get_values() const
@@ -139,16 +152,25 @@ namespace bq2579x
         ESP_LOGI(TAG, " WATCHDOG    : %s", to_string(v.watchdog));
     }
 
-    std::string ChargerControl1Register::to_json() const
+    void ChargerControl1Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"VBUS_BACKUP\": \"" + to_string(v.vbus_backup) + "\"," +
-               "\"VAC_OVP\": \"" + to_string(v.vac_ovp) + "\"," +
-               "\"WD_RST\": " + std::to_string(v.wd_rst) + "," +
-               "\"WATCHDOG\": \"" + to_string(v.watchdog) + "\"" +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"VBUS_BACKUP\": \"")
+            .raw(to_string(v.vbus_backup))
+            .raw("\",\"VAC_OVP\": \"")
+            .raw(to_string(v.vac_ovp))
+            .raw("\",\"WD_RST\": ")
+            .value(v.wd_rst)
+            .raw(",\"WATCHDOG\": \"")
+            .raw(to_string(v.watchdog))
+            .raw("\"}");
+    }
+
+    std::string ChargerControl1Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void ChargerControl2Register::set_values(const ChargerControl2Register::Values &v)
@@ -202,19 +224,31 @@ namespace bq2579x
         ESP_LOGI(TAG, " SDRV_CTRL=%s", to_string(v.sdrv_ctrl));
     }
 
-    std::string ChargerControl2Register::to_json() const
+    void ChargerControl2Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"FORCE_INDET\": " + std::to_string(v.force_indet) + "," +
-               "\"AUTO_INDET_EN\": " + std::to_string(v.auto_indet_en) + "," +
-               "\"EN_12V\": " + std::to_string(v.en_12v) + "," +
-               "\"EN_9V\": " + std::to_string(v.en_9v) + "," +
-               "\"HVDCP_EN\": " + std::to_string(v.hvdcp_en) + "," +
-               "\"SDRV_CTRL\": \"" + to_string(v.sdrv_ctrl) + "\"," +
-               "\"SDRV_DLY\": " + std::to_string(v.sdrv_dly) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"FORCE_INDET\": ")
+            .value(v.force_indet)
+            .raw(",\"AUTO_INDET_EN\": ")
+            .value(v.auto_indet_en)
+            .raw(",\"EN_12V\": ")
+            .value(v.en_12v)
+            .raw(",\"EN_9V\": ")
+            .value(v.en_9v)
+            .raw(",\"HVDCP_EN\": ")
+            .value(v.hvdcp_en)
+            .raw(",\"SDRV_CTRL\": \"")
+            .raw(to_string(v.sdrv_ctrl))
+            .raw("\",\"SDRV_DLY\": ")
+            .value(v.sdrv_dly)
+            .raw("}");
+    }
+
+    std::string ChargerControl2Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void ChargerControl3Register::set_values(const ChargerControl3Register::Values &v)
@@ -254,20 +288,33 @@ namespace bq2579x
                  v.dis_fwd_ooa);
     }
 
-    std::string ChargerControl3Register::to_json() const
+    void ChargerControl3Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"DIS_ACDRV\": " + std::to_string(v.dis_acdrv) + "," +
-               "\"EN_OTG\": " + std::to_string(v.en_otg) + "," +
-               "\"PFM_OTG_DIS\": " + std::to_string(v.pfm_otg_dis) + "," +
-               "\"PFM_FWD_DIS\": " + std::to_string(v.pfm_fwd_dis) + "," +
-               "\"WKUP_DLY\": \"" + std::string(v.wkup_dly ? "15 ms" : "1 s") + "\"," +
-               "\"DIS_LDO\": " + std::to_string(v.dis_ldo) + "," +
-               "\"DIS_OTG_OOA\": " + std::to_string(v.dis_otg_ooa) + "," +
-               "\"DIS_FWD_OOA\": " + std::to_string(v.dis_fwd_ooa) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"DIS_ACDRV\": ")
+            .value(v.dis_acdrv)
+            .raw(",\"EN_OTG\": ")
+            .value(v.en_otg)
+            .raw(",\"PFM_OTG_DIS\": ")
+            .value(v.pfm_otg_dis)
+            .raw(",\"PFM_FWD_DIS\": ")
+            .value(v.pfm_fwd_dis)
+            .raw(",\"WKUP_DLY\": \"")
+            .raw(v.wkup_dly ? "15 ms" : "1 s")
+            .raw("\",\"DIS_LDO\": ")
+            .value(v.dis_ldo)
+            .raw(",\"DIS_OTG_OOA\": ")
+            .value(v.dis_otg_ooa)
+            .raw(",\"DIS_FWD_OOA\": ")
+            .value(v.dis_fwd_ooa)
+            .raw("}");
+    }
+
+    std::string ChargerControl3Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void ChargerControl4Register::set_values(const ChargerControl4Register::Values &v)
@@ -305,20 +352,33 @@ namespace bq2579x
                  v.en_ibus_ocp);
     }
 
-    std::string ChargerControl4Register::to_json() const
+    void ChargerControl4Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"EN_ACDRV2\": " + std::to_string(v.en_acdrv2) + "," +
-               "\"EN_ACDRV1\": " + std::to_string(v.en_acdrv1) + "," +
-               "\"PWM_750KHZ\": " + std::to_string(v.pwm_freq_750khz) + "," +
-               "\"DIS_STAT\": " + std::to_string(v.dis_stat) + "," +
-               "\"DIS_VSYS_SHORT\": " + std::to_string(v.dis_vsys_short) + "," +
-               "\"DIS_VOTG_UVP\": " + std::to_string(v.dis_votg_uvp) + "," +
-               "\"FORCE_VINDPM\": " + std::to_string(v.force_vindpm_det) + "," +
-               "\"EN_IBUS_OCP\": " + std::to_string(v.en_ibus_ocp) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"EN_ACDRV2\": ")
+            .value(v.en_acdrv2)
+            .raw(",\"EN_ACDRV1\": ")
+            .value(v.en_acdrv1)
+            .raw(",\"PWM_750KHZ\": ")
+            .value(v.pwm_freq_750khz)
+            .raw(",\"DIS_STAT\": ")
+            .value(v.dis_stat)
+            .raw(",\"DIS_VSYS_SHORT\": ")
+            .value(v.dis_vsys_short)
+            .raw(",\"DIS_VOTG_UVP\": ")
+            .value(v.dis_votg_uvp)
+            .raw(",\"FORCE_VINDPM\": ")
+            .value(v.force_vindpm_det)
+            .raw(",\"EN_IBUS_OCP\": ")
+            .value(v.en_ibus_ocp)
+            .raw("}");
+    }
+
+    std::string ChargerControl4Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void ChargerControl5Register::set_values(const ChargerControl5Register::Values &v)
@@ -370,18 +430,29 @@ namespace bq2579x
         ESP_LOGI(TAG, " IBAT_REG=%s", to_string(v.ibat_reg));
     }
 
-    std::string ChargerControl5Register::to_json() const
+    void ChargerControl5Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"SFET_PRESENT\": " + std::to_string(v.sfet_present) + "," +
-               "\"EN_IBAT\": " + std::to_string(v.en_ibat) + "," +
-               "\"EN_IINDPM\": " + std::to_string(v.en_iindpm) + "," +
-               "\"EN_EXTILIM\": " + std::to_string(v.en_extilim) + "," +
-               "\"EN_BATOC\": " + std::to_string(v.en_batoc) + "," +
-               "\"IBAT_REG\": \"" + to_string(v.ibat_reg) + "\"" +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"SFET_PRESENT\": ")
+            .value(v.sfet_present)
+            .raw(",\"EN_IBAT\": ")
+            .value(v.en_ibat)
+            .raw(",\"EN_IINDPM\": ")
+            .value(v.en_iindpm)
+            .raw(",\"EN_EXTILIM\": ")
+            .value(v.en_extilim)
+            .raw(",\"EN_BATOC\": ")
+            .value(v.en_batoc)
+            .raw(",\"IBAT_REG\": \"")
+            .raw(to_string(v.ibat_reg))
+            .raw("\"}");
+    }
+
+    std::string ChargerControl5Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void ChargerControlRegister::log() const
@@ -394,15 +465,25 @@ namespace bq2579x
         charger_control5.log();
     }
 
+    void ChargerControlRegister::write_json(JsonWriter &w) const
+    {
+        w.raw("{\"charger_control0\": ");
+        charger_control0.write_json(w);
+        w.raw(",\"charger_control1\": ");
+        charger_control1.write_json(w);
+        w.raw(",\"charger_control2\": ");
+        charger_control2.write_json(w);
+        w.raw(",\"charger_control3\": ");
+        charger_control3.write_json(w);
+        w.raw(",\"charger_control4\": ");
+        charger_control4.write_json(w);
+        w.raw(",\"charger_control5\": ");
+        charger_control5.write_json(w);
+        w.raw("}");
+    }
+
     std::string ChargerControlRegister::to_json() const
     {
-        return std::string("{") +
-               "\"charger_control0\": " + charger_control0.to_json() + "," +
-               "\"charger_control1\": " + charger_control1.to_json() + "," +
-               "\"charger_control2\": " + charger_control2.to_json() + "," +
-               "\"charger_control3\": " + charger_control3.to_json() + "," +
-               "\"charger_control4\": " + charger_control4.to_json() + "," +
-               "\"charger_control5\": " + charger_control5.to_json() +
-               "}";
+        return to_json_string(*this);
     }
 }
\ No newline at end of file
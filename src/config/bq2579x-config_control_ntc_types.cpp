@@ -70,15 +70,23 @@ namespace bq2579x
         ESP_LOGI(TAG, " JEITA_ISETC : %s", to_string(v.jeita_isetc));
     }
 
-    std::string NTCControl0Register::to_json() const
+    void NTCControl0Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"JEITA_VSET\": \"" + to_string(v.jeita_vset) + "\"," +
-               "\"JEITA_ISETH\": \"" + to_string(v.jeita_iseth) + "\"," +
-               "\"JEITA_ISETC\": \"" + to_string(v.jeita_isetc) + "\"" +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"JEITA_VSET\": \"")
+            .raw(to_string(v.jeita_vset))
+            .raw("\",\"JEITA_ISETH\": \"")
+            .raw(to_string(v.jeita_iseth))
+            .raw("\",\"JEITA_ISETC\": \"")
+            .raw(to_string(v.jeita_isetc))
+            .raw("\"}");
+    }
+
+    std::string NTCControl0Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void NTCControl1Register::set_values(const NTCControl1Register::Values &v)
@@ -176,17 +184,27 @@ namespace bq2579x
         ESP_LOGI(TAG, " TS_IGNORE: %d", v.ts_ignore);
     }
 
-    std::string NTCControl1Register::to_json() const
+    void NTCControl1Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"TS_COOL\": \"" + to_string(v.ts_cool) + "\"," +
-               "\"TS_WARM\": \"" + to_string(v.ts_warm) + "\"," +
-               "\"BHOT\": \"" + to_string(v.bhot) + "\"," +
-               "\"BCOLD\": \"" + to_string(v.bcold) + "\"," +
-               "\"TS_IGNORE\": " + std::to_string(v.ts_ignore) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"TS_COOL\": \"")
+            .raw(to_string(v.ts_cool))
+            .raw("\",\"TS_WARM\": \"")
+            .raw(to_string(v.ts_warm))
+            .raw("\",\"BHOT\": \"")
+            .raw(to_string(v.bhot))
+            .raw("\",\"BCOLD\": \"")
+            .raw(to_string(v.bcold))
+            .raw("\",\"TS_IGNORE\": ")
+            .value(v.ts_ignore)
+            .raw("}");
+    }
+
+    std::string NTCControl1Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void NTCControlRegister::log() const
@@ -195,11 +213,17 @@ namespace bq2579x
         ntc_control1.log();
     }
 
+    void NTCControlRegister::write_json(JsonWriter &w) const
+    {
+        w.raw("{\"ntc_control0\": ");
+        ntc_control0.write_json(w);
+        w.raw(",\"ntc_control1\": ");
+        ntc_control1.write_json(w);
+        w.raw("}");
+    }
+
     std::string NTCControlRegister::to_json() const
     {
-        return std::string("{") +
-               "\"ntc_control0\": " + ntc_control0.to_json() + "," +
-               "\"ntc_control1\": " + ntc_control1.to_json() +
-               "}";
+        return to_json_string(*this);
     }
 }
\ No newline at end of file
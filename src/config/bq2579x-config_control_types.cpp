@@ -45,14 +45,21 @@ namespace bq2579x
         ESP_LOGI(TAG, " VBAT_LOWV : %s", to_string(v.threshold));
     }
 
-    std::string PrechargeControlRegister::to_json() const
+    void PrechargeControlRegister::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"IPRECHG\": " + std::to_string(v.precharge_current_ma) + "," +
-               "\"VBAT_LOWV\": \"" + to_string(v.threshold) + "\"" +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"IPRECHG\": ")
+            .value(v.precharge_current_ma)
+            .raw(",\"VBAT_LOWV\": \"")
+            .raw(to_string(v.threshold))
+            .raw("\"}");
+    }
+
+    std::string PrechargeControlRegister::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void TerminationControlRegister::set_values(const TerminationControlRegister::Values &v)
@@ -82,15 +89,23 @@ namespace bq2579x
                  v.iterm_ma);
     }
 
-    std::string TerminationControlRegister::to_json() const
+    void TerminationControlRegister::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"REG_RST\": " + std::to_string(v.reg_rst) + "," +
-               "\"STOP_WD_CHG\": " + std::to_string(v.stop_wd_chg) + "," +
-               "\"ITERM\": " + std::to_string(v.iterm_ma) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"REG_RST\": ")
+            .value(v.reg_rst)
+            .raw(",\"STOP_WD_CHG\": ")
+            .value(v.stop_wd_chg)
+            .raw(",\"ITERM\": ")
+            .value(v.iterm_ma)
+            .raw("}");
+    }
+
+    std::string TerminationControlRegister::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void RechargeControlRegister::set_values(const RechargeControlRegister::Values &v)
@@ -151,15 +166,23 @@ namespace bq2579x
         ESP_LOGI(TAG, " Deglitch Time     : %s", to_string(v.trechg));
         ESP_LOGI(TAG, " Recharge Offset   : %d mV", v.vrechg_offset_mv);
     }
-    std::string RechargeControlRegister::to_json() const
+    void RechargeControlRegister::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"cell_count\": \"" + to_string(v.cell_count) + "\"," +
-               "\"deglitch_time\": \"" + to_string(v.trechg) + "\"," +
-               "\"vrechg_offset_mv\": " + std::to_string(v.vrechg_offset_mv) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"cell_count\": \"")
+            .raw(to_string(v.cell_count))
+            .raw("\",\"deglitch_time\": \"")
+            .raw(to_string(v.trechg))
+            .raw("\",\"vrechg_offset_mv\": ")
+            .value(v.vrechg_offset_mv)
+            .raw("}");
+    }
+
+    std::string RechargeControlRegister::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void TimerControlRegister::set_values(const TimerControlRegister::Values &v)
@@ -227,18 +250,29 @@ namespace bq2579x
         ESP_LOGI(TAG, " TMR2X_EN    : %d", v.tmr2x_en);
     }
 
-    std::string TimerControlRegister::to_json() const
+    void TimerControlRegister::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"TOPOFF_TMR\": \"" + to_string(v.topoff_timer) + "\"," +
-               "\"EN_CHG_TMR\": " + std::to_string(v.en_chg_timer) + "," +
-               "\"EN_PRECHG\": " + std::to_string(v.en_prechg_timer) + "," +
-               "\"EN_TRICKLE\": " + std::to_string(v.en_trichg_timer) + "," +
-               "\"CHG_TMR\": \"" + to_string(v.chg_timer) + "\"," +
-               "\"TMR2X_EN\": " + std::to_string(v.tmr2x_en) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"TOPOFF_TMR\": \"")
+            .raw(to_string(v.topoff_timer))
+            .raw("\",\"EN_CHG_TMR\": ")
+            .value(v.en_chg_timer)
+            .raw(",\"EN_PRECHG\": ")
+            .value(v.en_prechg_timer)
+            .raw(",\"EN_TRICKLE\": ")
+            .value(v.en_trichg_timer)
+            .raw(",\"CHG_TMR\": \"")
+            .raw(to_string(v.chg_timer))
+            .raw("\",\"TMR2X_EN\": ")
+            .value(v.tmr2x_en)
+            .raw("}");
+    }
+
+    std::string TimerControlRegister::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void MPPTControlRegister::set_values(const MPPTControlRegister::Values &v)
@@ -328,16 +362,25 @@ namespace bq2579x
         ESP_LOGI(TAG, " EN_MPPT  : %d", v.en_mppt);
     }
 
-    std::string MPPTControlRegister::to_json() const
+    void MPPTControlRegister::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"VOC_PCT\": \"" + to_string(v.voc_pct) + "\"," +
-               "\"VOC_DLY\": \"" + to_string(v.voc_dly) + "\"," +
-               "\"VOC_RATE\": \"" + to_string(v.voc_rate) + "\"," +
-               "\"EN_MPPT\": " + std::to_string(v.en_mppt) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"VOC_PCT\": \"")
+            .raw(to_string(v.voc_pct))
+            .raw("\",\"VOC_DLY\": \"")
+            .raw(to_string(v.voc_dly))
+            .raw("\",\"VOC_RATE\": \"")
+            .raw(to_string(v.voc_rate))
+            .raw("\",\"EN_MPPT\": ")
+            .value(v.en_mppt)
+            .raw("}");
+    }
+
+    std::string MPPTControlRegister::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void TemperatureControlRegister::set_values(const TemperatureControlRegister::Values &v)
@@ -407,18 +450,29 @@ namespace bq2579x
                  v.bkup_acfet1_on);
     }
 
-    std::string TemperatureControlRegister::to_json() const
+    void TemperatureControlRegister::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"THERM_REG\": \"" + to_string(v.treg) + "\"," +
-               "\"THERM_SHDN\": \"" + to_string(v.tshut) + "\"," +
-               "\"VBUS_PD_EN\": " + std::to_string(v.vbus_pd_en) + "," +
-               "\"VAC1_PD_EN\": " + std::to_string(v.vac1_pd_en) + "," +
-               "\"VAC2_PD_EN\": " + std::to_string(v.vac2_pd_en) + "," +
-               "\"BKUP_ACFET1_ON\": " + std::to_string(v.bkup_acfet1_on) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"THERM_REG\": \"")
+            .raw(to_string(v.treg))
+            .raw("\",\"THERM_SHDN\": \"")
+            .raw(to_string(v.tshut))
+            .raw("\",\"VBUS_PD_EN\": ")
+            .value(v.vbus_pd_en)
+            .raw(",\"VAC1_PD_EN\": ")
+            .value(v.vac1_pd_en)
+            .raw(",\"VAC2_PD_EN\": ")
+            .value(v.vac2_pd_en)
+            .raw(",\"BKUP_ACFET1_ON\": ")
+            .value(v.bkup_acfet1_on)
+            .raw("}");
+    }
+
+    std::string TemperatureControlRegister::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void DPDMDriverRegister::set_values(const DPDMDriverRegister::Values &v)
@@ -469,14 +523,21 @@ namespace bq2579x
         ESP_LOGI(TAG, " D- Level : %s", to_string(v.dminus));
     }
 
-    std::string DPDMDriverRegister::to_json() const
+    void DPDMDriverRegister::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"DP_LEVEL\": \"" + to_string(v.dplus) + "\"," +
-               "\"DM_LEVEL\": \"" + to_string(v.dminus) + "\"" +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"DP_LEVEL\": \"")
+            .raw(to_string(v.dplus))
+            .raw("\",\"DM_LEVEL\": \"")
+            .raw(to_string(v.dminus))
+            .raw("\"}");
+    }
+
+    std::string DPDMDriverRegister::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void ConfigControl::log() const
@@ -492,19 +553,32 @@ namespace bq2579x
         dpdm.log();
     }
 
+    void ConfigControl::write_json(JsonWriter &w) const
+    {
+        w.raw("{\"pre_charge\": ");
+        pre_charge.write_json(w);
+        w.raw(",\"termination\": ");
+        termination.write_json(w);
+        w.raw(",\"re_charge\": ");
+        re_charge.write_json(w);
+        w.raw(",\"timer\": ");
+        timer.write_json(w);
+        w.raw(",\"charger\": ");
+        charger.write_json(w);
+        w.raw(",\"mppt\": ");
+        mppt.write_json(w);
+        w.raw(",\"temperature\": ");
+        temperature.write_json(w);
+        w.raw(",\"ntc\": ");
+        ntc.write_json(w);
+        w.raw(",\"dpdm\": ");
+        dpdm.write_json(w);
+        w.raw("}");
+    }
+
     std::string ConfigControl::to_json() const
     {
-        return std::string("{") +
-               "\"pre_charge\": " + pre_charge.to_json() + "," +
-               "\"termination\": " + termination.to_json() + "," +
-               "\"re_charge\": " + re_charge.to_json() + "," +
-               "\"timer\": " + timer.to_json() + "," +
-               "\"charger\": " + charger.to_json() + "," +
-               "\"mppt\": " + mppt.to_json() + "," +
-               "\"temperature\": " + temperature.to_json() + "," +
-               "\"ntc\": " + ntc.to_json() + "," +
-               "\"dpdm\": " + dpdm.to_json() +
-               "}";
+        return to_json_string(*this);
     }
 
 }
\ No newline at end of file
@@ -113,20 +113,31 @@ namespace bq2579x
         ESP_LOGI("BQ2579X_ConfigLimit", " PrechargeTimer : %s", otg.precharge_timer_short ? "0.5h" : "2h");
     }
 
-    std::string ConfigLimit::to_json() const
+    void ConfigLimit::write_json(JsonWriter &w) const
     {
         IOTGRegulationRegister::Values otg = iotg_values.get_values();
+        w.raw("{\"vsysmin_mv\": ")
+            .value(vsysmin_mv.get_value())
+            .raw(",\"vreg_mv\": ")
+            .value(vreg_mv.get_value())
+            .raw(",\"ichg_ma\": ")
+            .value(ichg_ma.get_value())
+            .raw(",\"vindpm_mv\": ")
+            .value(vindpm_mv.get_value())
+            .raw(",\"iindpm_ma\": ")
+            .value(iindpm_ma.get_value())
+            .raw(",\"votg_mv\": ")
+            .value(votg_mv.get_value())
+            .raw(",\"iotg_ma\": ")
+            .value(otg.otg_current_ma)
+            .raw(",\"precharge_timer_short\": ")
+            .value(otg.precharge_timer_short)
+            .raw("}");
+    }
 
-        return std::string("{") +
-               "\"vsysmin_mv\": " + std::to_string(vsysmin_mv.get_value()) + "," +
-               "\"vreg_mv\": " + std::to_string(vreg_mv.get_value()) + "," +
-               "\"ichg_ma\": " + std::to_string(ichg_ma.get_value()) + "," +
-               "\"vindpm_mv\": " + std::to_string(vindpm_mv.get_value()) + "," +
-               "\"iindpm_ma\": " + std::to_string(iindpm_ma.get_value()) + "," +
-               "\"votg_mv\": " + std::to_string(votg_mv.get_value()) + "," +
-               "\"iotg_ma\": " + std::to_string(otg.otg_current_ma) + "," +
-               "\"precharge_timer_short\": " + std::to_string(otg.precharge_timer_short) +
-               "}";
+    std::string ConfigLimit::to_json() const
+    {
+        return to_json_string(*this);
     }
 
 }
\ No newline at end of file
@@ -36,20 +36,33 @@ namespace bq2579x
                  v.iindpm_mask, v.vindpm_mask, v.wd_mask, v.poorsrc_mask, v.pg_mask, v.ac2_present_mask, v.ac1_present_mask, v.vbus_present_mask);
     }
 
-    std::string ChargerMask0Register::to_json() const
+    void ChargerMask0Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"IINDPM_MASK\": " + std::to_string(v.iindpm_mask) + "," +
-               "\"VINDPM_MASK\": " + std::to_string(v.vindpm_mask) + "," +
-               "\"WD_MASK\": " + std::to_string(v.wd_mask) + "," +
-               "\"POORSRC_MASK\": " + std::to_string(v.poorsrc_mask) + "," +
-               "\"PG_MASK\": " + std::to_string(v.pg_mask) + "," +
-               "\"AC2_PRESENT_MASK\": " + std::to_string(v.ac2_present_mask) + "," +
-               "\"AC1_PRESENT_MASK\": " + std::to_string(v.ac1_present_mask) + "," +
-               "\"VBUS_PRESENT_MASK\": " + std::to_string(v.vbus_present_mask) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"IINDPM_MASK\": ")
+            .value(v.iindpm_mask)
+            .raw(",\"VINDPM_MASK\": ")
+            .value(v.vindpm_mask)
+            .raw(",\"WD_MASK\": ")
+            .value(v.wd_mask)
+            .raw(",\"POORSRC_MASK\": ")
+            .value(v.poorsrc_mask)
+            .raw(",\"PG_MASK\": ")
+            .value(v.pg_mask)
+            .raw(",\"AC2_PRESENT_MASK\": ")
+            .value(v.ac2_present_mask)
+            .raw(",\"AC1_PRESENT_MASK\": ")
+            .value(v.ac1_present_mask)
+            .raw(",\"VBUS_PRESENT_MASK\": ")
+            .value(v.vbus_present_mask)
+            .raw("}");
+    }
+
+    std::string ChargerMask0Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     ChargerMask1Register::Values ChargerMask1Register::get_values() const
@@ -77,18 +90,29 @@ namespace bq2579x
                  v.chg_mask, v.ico_mask, v.vbus_mask, v.treg_mask, v.vbat_present_mask, v.bc1_2_done_mask);
     }
 
-    std::string ChargerMask1Register::to_json() const
+    void ChargerMask1Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"CHG_MASK\": " + std::to_string(v.chg_mask) + "," +
-               "\"ICO_MASK\": " + std::to_string(v.ico_mask) + "," +
-               "\"VBUS_MASK\": " + std::to_string(v.vbus_mask) + "," +
-               "\"TREG_MASK\": " + std::to_string(v.treg_mask) + "," +
-               "\"VBAT_PRESENT_MASK\": " + std::to_string(v.vbat_present_mask) + "," +
-               "\"BC1_2_DONE_MASK\": " + std::to_string(v.bc1_2_done_mask) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"CHG_MASK\": ")
+            .value(v.chg_mask)
+            .raw(",\"ICO_MASK\": ")
+            .value(v.ico_mask)
+            .raw(",\"VBUS_MASK\": ")
+            .value(v.vbus_mask)
+            .raw(",\"TREG_MASK\": ")
+            .value(v.treg_mask)
+            .raw(",\"VBAT_PRESENT_MASK\": ")
+            .value(v.vbat_present_mask)
+            .raw(",\"BC1_2_DONE_MASK\": ")
+            .value(v.bc1_2_done_mask)
+            .raw("}");
+    }
+
+    std::string ChargerMask1Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     ChargerMask2Register::Values ChargerMask2Register::get_values() const
@@ -117,19 +141,31 @@ namespace bq2579x
                  v.dpdm_done_mask, v.adc_done_mask, v.vsys_mask, v.chg_tmr_mask, v.trichg_tmr_mask, v.prechg_tmr_mask, v.topoff_tmr_mask);
     }
 
-    std::string ChargerMask2Register::to_json() const
+    void ChargerMask2Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"DPDM_DONE_MASK\": " + std::to_string(v.dpdm_done_mask) + "," +
-               "\"ADC_DONE_MASK\": " + std::to_string(v.adc_done_mask) + "," +
-               "\"VSYS_MASK\": " + std::to_string(v.vsys_mask) + "," +
-               "\"CHG_TMR_MASK\": " + std::to_string(v.chg_tmr_mask) + "," +
-               "\"TRICHG_TMR_MASK\": " + std::to_string(v.trichg_tmr_mask) + "," +
-               "\"PRECHG_TMR_MASK\": " + std::to_string(v.prechg_tmr_mask) + "," +
-               "\"TOPOFF_TMR_MASK\": " + std::to_string(v.topoff_tmr_mask) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"DPDM_DONE_MASK\": ")
+            .value(v.dpdm_done_mask)
+            .raw(",\"ADC_DONE_MASK\": ")
+            .value(v.adc_done_mask)
+            .raw(",\"VSYS_MASK\": ")
+            .value(v.vsys_mask)
+            .raw(",\"CHG_TMR_MASK\": ")
+            .value(v.chg_tmr_mask)
+            .raw(",\"TRICHG_TMR_MASK\": ")
+            .value(v.trichg_tmr_mask)
+            .raw(",\"PRECHG_TMR_MASK\": ")
+            .value(v.prechg_tmr_mask)
+            .raw(",\"TOPOFF_TMR_MASK\": ")
+            .value(v.topoff_tmr_mask)
+            .raw("}");
+    }
+
+    std::string ChargerMask2Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     ChargerMask3Register::Values ChargerMask3Register::get_values() const
@@ -151,17 +187,27 @@ namespace bq2579x
                  v.vbatotg_low_mask, v.ts_cold_mask, v.ts_cool_mask, v.ts_warm_mask, v.ts_hot_mask);
     }
 
-    std::string ChargerMask3Register::to_json() const
+    void ChargerMask3Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"VBATOTG_LOW_MASK\": " + std::to_string(v.vbatotg_low_mask) + "," +
-               "\"TS_COLD_MASK\": " + std::to_string(v.ts_cold_mask) + "," +
-               "\"TS_COOL_MASK\": " + std::to_string(v.ts_cool_mask) + "," +
-               "\"TS_WARM_MASK\": " + std::to_string(v.ts_warm_mask) + "," +
-               "\"TS_HOT_MASK\": " + std::to_string(v.ts_hot_mask) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"VBATOTG_LOW_MASK\": ")
+            .value(v.vbatotg_low_mask)
+            .raw(",\"TS_COLD_MASK\": ")
+            .value(v.ts_cold_mask)
+            .raw(",\"TS_COOL_MASK\": ")
+            .value(v.ts_cool_mask)
+            .raw(",\"TS_WARM_MASK\": ")
+            .value(v.ts_warm_mask)
+            .raw(",\"TS_HOT_MASK\": ")
+            .value(v.ts_hot_mask)
+            .raw("}");
+    }
+
+    std::string ChargerMask3Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void FaultMask0Register::set_values(const FaultMask0Register::Values &v)
@@ -191,20 +237,33 @@ namespace bq2579x
                  v.ibat_reg_mask, v.vbus_ovp_mask, v.vbat_ovp_mask, v.ibus_ocp_mask, v.ibat_ocp_mask, v.conv_ocp_mask, v.vac2_ovp_mask, v.vac1_ovp_mask);
     }
 
-    std::string FaultMask0Register::to_json() const
+    void FaultMask0Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"IBAT_REG_MASK\": " + std::to_string(v.ibat_reg_mask) + "," +
-               "\"VBUS_OVP_MASK\": " + std::to_string(v.vbus_ovp_mask) + "," +
-               "\"VBAT_OVP_MASK\": " + std::to_string(v.vbat_ovp_mask) + "," +
-               "\"IBUS_OCP_MASK\": " + std::to_string(v.ibus_ocp_mask) + "," +
-               "\"IBAT_OCP_MASK\": " + std::to_string(v.ibat_ocp_mask) + "," +
-               "\"CONV_OCP_MASK\": " + std::to_string(v.conv_ocp_mask) + "," +
-               "\"VAC2_OVP_MASK\": " + std::to_string(v.vac2_ovp_mask) + "," +
-               "\"VAC1_OVP_MASK\": " + std::to_string(v.vac1_ovp_mask) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"IBAT_REG_MASK\": ")
+            .value(v.ibat_reg_mask)
+            .raw(",\"VBUS_OVP_MASK\": ")
+            .value(v.vbus_ovp_mask)
+            .raw(",\"VBAT_OVP_MASK\": ")
+            .value(v.vbat_ovp_mask)
+            .raw(",\"IBUS_OCP_MASK\": ")
+            .value(v.ibus_ocp_mask)
+            .raw(",\"IBAT_OCP_MASK\": ")
+            .value(v.ibat_ocp_mask)
+            .raw(",\"CONV_OCP_MASK\": ")
+            .value(v.conv_ocp_mask)
+            .raw(",\"VAC2_OVP_MASK\": ")
+            .value(v.vac2_ovp_mask)
+            .raw(",\"VAC1_OVP_MASK\": ")
+            .value(v.vac1_ovp_mask)
+            .raw("}");
+    }
+
+    std::string FaultMask0Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void FaultMask1Register::set_values(const FaultMask1Register::Values &v)
@@ -232,17 +291,27 @@ namespace bq2579x
                  v.vsys_short_mask, v.vsys_ovp_mask, v.otg_ovp_mask, v.otg_uvp_mask, v.tshut_mask);
     }
 
-    std::string FaultMask1Register::to_json() const
+    void FaultMask1Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"VSYS_SHORT_MASK\": " + std::to_string(v.vsys_short_mask) + "," +
-               "\"VSYS_OVP_MASK\": " + std::to_string(v.vsys_ovp_mask) + "," +
-               "\"OTG_OVP_MASK\": " + std::to_string(v.otg_ovp_mask) + "," +
-               "\"OTG_UVP_MASK\": " + std::to_string(v.otg_uvp_mask) + "," +
-               "\"TSHUT_MASK\": " + std::to_string(v.tshut_mask) +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"VSYS_SHORT_MASK\": ")
+            .value(v.vsys_short_mask)
+            .raw(",\"VSYS_OVP_MASK\": ")
+            .value(v.vsys_ovp_mask)
+            .raw(",\"OTG_OVP_MASK\": ")
+            .value(v.otg_ovp_mask)
+            .raw(",\"OTG_UVP_MASK\": ")
+            .value(v.otg_uvp_mask)
+            .raw(",\"TSHUT_MASK\": ")
+            .value(v.tshut_mask)
+            .raw("}");
+    }
+
+    std::string FaultMask1Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     void ChargerMaskRegister::log() const
@@ -253,14 +322,22 @@ namespace bq2579x
         charger_mask3.log();
     };
 
+    void ChargerMaskRegister::write_json(JsonWriter &w) const
+    {
+        w.raw("{\"charger_mask0\": ");
+        charger_mask0.write_json(w);
+        w.raw(",\"charger_mask1\": ");
+        charger_mask1.write_json(w);
+        w.raw(",\"charger_mask2\": ");
+        charger_mask2.write_json(w);
+        w.raw(",\"charger_mask3\": ");
+        charger_mask3.write_json(w);
+        w.raw("}");
+    }
+
     std::string ChargerMaskRegister::to_json() const
     {
-        return std::string("{") +
-               "\"charger_mask0\": " + charger_mask0.to_json() + "," +
-               "\"charger_mask1\": " + charger_mask1.to_json() + "," +
-               "\"charger_mask2\": " + charger_mask2.to_json() + "," +
-               "\"charger_mask3\": " + charger_mask3.to_json() +
-               "}";
+        return to_json_string(*this);
     }
 
     void FaultMaskRegister::log() const
@@ -269,12 +346,18 @@ namespace bq2579x
         fault_mask1.log();
     };
 
+    void FaultMaskRegister::write_json(JsonWriter &w) const
+    {
+        w.raw("{\"fault_mask0\": ");
+        fault_mask0.write_json(w);
+        w.raw(",\"fault_mask1\": ");
+        fault_mask1.write_json(w);
+        w.raw("}");
+    }
+
     std::string FaultMaskRegister::to_json() const
     {
-        return std::string("{") +
-               "\"fault_mask0\": " + fault_mask0.to_json() + "," +
-               "\"fault_mask1\": " + fault_mask1.to_json() +
-               "}";
+        return to_json_string(*this);
     }
 
     void ConfigMask::log() const
@@ -283,12 +366,18 @@ namespace bq2579x
         fault_mask.log();
     };
 
+    void ConfigMask::write_json(JsonWriter &w) const
+    {
+        w.raw("{\"charger_mask\": ");
+        charger_mask.write_json(w);
+        w.raw(",\"fault_mask\": ");
+        fault_mask.write_json(w);
+        w.raw("}");
+    }
+
     std::string ConfigMask::to_json() const
     {
-        return std::string("{") +
-               "\"charger_mask\": " + charger_mask.to_json() + "," +
-               "\"fault_mask\": " + fault_mask.to_json() +
-               "}";
+        return to_json_string(*this);
     }
 
 }
\ No newline at end of file
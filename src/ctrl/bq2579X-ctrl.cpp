@@ -1,6 +1,10 @@
 #include "ctrl/bq2579x-ctrl.hpp"
 
 #include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 #define RETURN_IF_ERROR(x)                       \
     do                                           \
@@ -49,6 +53,50 @@ namespace bq2579x
         return ESP_OK;
     }
 
+    esp_err_t CTRL::adc_done(bool &done)
+    {
+        uint8_t status;
+        RETURN_IF_ERROR(read_u8(REG_CHARGER_STATUS3, status));
+        done = status & ADC_DONE_STAT;
+        return ESP_OK;
+    }
+
+    esp_err_t CTRL::convert_oneshot(uint32_t expected_us, uint32_t timeout_us)
+    {
+        const int64_t start_us = esp_timer_get_time();
+        RETURN_IF_ERROR(en_adc());
+
+        const int64_t ready_us = start_us + expected_us;
+        const int64_t deadline_us = start_us + timeout_us;
+        const uint32_t tick_us = portTICK_PERIOD_MS * 1000;
+        while (true)
+        {
+            const int64_t now_us = esp_timer_get_time();
+            if (now_us >= ready_us)
+            {
+                bool done;
+                RETURN_IF_ERROR(adc_done(done));
+                if (done)
+                    return ESP_OK;
+                if (now_us >= deadline_us)
+                {
+                    ESP_LOGW(TAG, "Conversion ADC non terminée après %lu us", static_cast<unsigned long>(timeout_us));
+                    return ESP_ERR_TIMEOUT;
+                }
+                // Sondage suivant au tick : la tâche ne monopolise pas le cœur
+                vTaskDelay(1);
+                continue;
+            }
+
+            // Attente active seulement sous ADC_SPIN_MAX_US ; sinon arrondi au tick supérieur
+            const uint32_t wait_us = static_cast<uint32_t>(ready_us - now_us);
+            if (wait_us < ADC_SPIN_MAX_US)
+                esp_rom_delay_us(wait_us);
+            else
+                vTaskDelay((wait_us + tick_us - 1) / tick_us);
+        }
+    }
+
     esp_err_t CTRL::get_ico_current_limit()
     {
         uint16_t val;
@@ -57,145 +105,218 @@ namespace bq2579x
         return ESP_OK;
     }
 
-    esp_err_t CTRL::get_ibus_adc()
+    esp_err_t CTRL::get_adc_channel(ADCChannel ch)
     {
         uint16_t val;
-        RETURN_IF_ERROR(read_u16(ibus_adc_ma.reg_addr, val));
-        ibus_adc_ma.set_raw(val);
+        RETURN_IF_ERROR(read_u16(adc_channel_reg(ch), val));
+        adc_snapshot_.raw[static_cast<size_t>(ch)] = val;
+        adc_snapshot_.valid |= adc_channel_bit(ch);
         return ESP_OK;
     }
 
+    esp_err_t CTRL::get_ibus_adc()
+    {
+        return get_adc_channel(ADCChannel::IBUS);
+    }
+
     esp_err_t CTRL::get_ibat_adc()
     {
-        uint16_t val;
-        RETURN_IF_ERROR(read_u16(ibat_adc_ma.reg_addr, val));
-        ibat_adc_ma.set_raw(val);
-        return ESP_OK;
+        return get_adc_channel(ADCChannel::IBAT);
     }
 
     esp_err_t CTRL::get_vbus_adc()
     {
-        uint16_t val;
-        RETURN_IF_ERROR(read_u16(vbus_adc_mv.reg_addr, val));
-        vbus_adc_mv.set_raw(val);
-        return ESP_OK;
+        return get_adc_channel(ADCChannel::VBUS);
     }
 
     esp_err_t CTRL::get_vac1_adc()
     {
-        uint16_t val;
-        RETURN_IF_ERROR(read_u16(vac1_adc_mv.reg_addr, val));
-        vac1_adc_mv.set_raw(val);
-        return ESP_OK;
+        return get_adc_channel(ADCChannel::VAC1);
     }
 
     esp_err_t CTRL::get_vacd2_adc()
     {
-        uint16_t val;
-        RETURN_IF_ERROR(read_u16(vacd2_adc_mv.reg_addr, val));
-        vacd2_adc_mv.set_raw(val);
-        return ESP_OK;
+        return get_adc_channel(ADCChannel::VAC2);
     }
 
     esp_err_t CTRL::get_vbat_adc()
     {
-        uint16_t val;
-        RETURN_IF_ERROR(read_u16(vbat_adc_mv.reg_addr, val));
-        vbat_adc_mv.set_raw(val);
-        return ESP_OK;
+        return get_adc_channel(ADCChannel::VBAT);
     }
 
     esp_err_t CTRL::get_vsys_adc()
     {
-        uint16_t val;
-        RETURN_IF_ERROR(read_u16(vsys_adc_mv.reg_addr, val));
-        vsys_adc_mv.set_raw(val);
-        return ESP_OK;
+        return get_adc_channel(ADCChannel::VSYS);
     }
 
     esp_err_t CTRL::get_ts_adc()
     {
-        uint16_t val;
-        RETURN_IF_ERROR(read_u16(ts_adc_mp.reg_addr, val));
-        ts_adc_mp.set_raw(val);
-        return ESP_OK;
+        return get_adc_channel(ADCChannel::TS);
     }
 
     esp_err_t CTRL::get_tdie_adc()
     {
-        uint16_t val;
-        RETURN_IF_ERROR(read_u16(tdie_adc_dc.reg_addr, val));
-        tdie_adc_dc.set_raw(val);
-        return ESP_OK;
+        return get_adc_channel(ADCChannel::TDIE);
     }
 
     esp_err_t CTRL::get_dplus_adc()
     {
-        uint16_t val;
-        RETURN_IF_ERROR(read_u16(dplus_adc_mv.reg_addr, val));
-        dplus_adc_mv.set_raw(val);
-        return ESP_OK;
+        return get_adc_channel(ADCChannel::DPLUS);
     }
 
     esp_err_t CTRL::get_dminus_adc()
     {
-        uint16_t val;
-        RETURN_IF_ERROR(read_u16(dminus_adc_mv.reg_addr, val));
-        dminus_adc_mv.set_raw(val);
+        return get_adc_channel(ADCChannel::DMINUS);
+    }
+
+    void CTRL::decode_adc_block(const uint8_t *block, uint16_t channels)
+    {
+        for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+        {
+            if (channels & (1u << i))
+                adc_snapshot_.raw[i] = to_u16(&block[adc_channel_reg(static_cast<ADCChannel>(i)) - ADC_BLOCK_START]);
+        }
+    }
+
+    CTRL::ADCReadPlan CTRL::plan_adc_reads(uint16_t channels)
+    {
+        ADCReadPlan plan;
+        plan.channels = channels & ADC_ALL_CHANNELS;
+
+        for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+        {
+            if (!(plan.channels & (1u << i)))
+                continue;
+
+            const uint8_t reg = adc_channel_reg(static_cast<ADCChannel>(i));
+            if (plan.count > 0)
+            {
+                ADCReadPlan::Span &last = plan.spans[plan.count - 1];
+                const size_t gap = reg - (last.reg + last.len);
+                // Relire quelques octets inutiles coûte moins qu'une nouvelle transaction
+                if (gap < ADC_TRANSACTION_OVERHEAD_BYTES)
+                {
+                    last.len = static_cast<uint8_t>(last.len + gap + 2);
+                    continue;
+                }
+            }
+            plan.spans[plan.count++] = {reg, 2};
+        }
+        return plan;
+    }
+
+    void CTRL::set_adc_channels(uint16_t channels)
+    {
+        adc_plan_ = plan_adc_reads(channels);
+    }
+
+    esp_err_t CTRL::read_adc_plan(const ADCReadPlan &plan)
+    {
+        // Rafales du plan uniquement : les voies désactivées ne coûtent rien sur le bus
+        uint8_t block[ADC_BLOCK_LEN] = {};
+        adc_snapshot_.valid = 0;
+        adc_snapshot_.timestamp_us = esp_timer_get_time();
+        for (size_t i = 0; i < plan.count; ++i)
+        {
+            const ADCReadPlan::Span &span = plan.spans[i];
+            RETURN_IF_ERROR(read_register(span.reg, &block[span.reg - ADC_BLOCK_START], span.len));
+        }
+        decode_adc_block(block, plan.channels);
+        adc_snapshot_.valid = plan.channels;
         return ESP_OK;
     }
 
+    esp_err_t CTRL::get_adc()
+    {
+        return read_adc_plan(adc_plan_);
+    }
+
+    esp_err_t CTRL::get_adc(uint16_t channels)
+    {
+        const uint16_t wanted = adc_plan_.channels & channels;
+        if (wanted == adc_plan_.channels)
+            return read_adc_plan(adc_plan_);
+        // Groupes échus ensemble : un seul plan, les voies contiguës partagent une rafale
+        return read_adc_plan(plan_adc_reads(wanted));
+    }
+
     esp_err_t CTRL::get()
     {
         RETURN_IF_ERROR(get_ico_current_limit());
-        RETURN_IF_ERROR(get_ibus_adc());
-        RETURN_IF_ERROR(get_ibat_adc());
-        RETURN_IF_ERROR(get_vbus_adc());
-        RETURN_IF_ERROR(get_vac1_adc());
-        RETURN_IF_ERROR(get_vacd2_adc());
-        RETURN_IF_ERROR(get_vbat_adc());
-        RETURN_IF_ERROR(get_vsys_adc());
-        RETURN_IF_ERROR(get_ts_adc());
-        RETURN_IF_ERROR(get_tdie_adc());
-        RETURN_IF_ERROR(get_dplus_adc());
-        RETURN_IF_ERROR(get_dminus_adc());
+        RETURN_IF_ERROR(get_adc());
         return ESP_OK;
     }
 
+    void CTRL::to_sample(ADCSample &out) const
+    {
+        for (size_t i = 0; i < ADC_CHANNEL_COUNT; ++i)
+            out.value[i] = adc_snapshot_.value(static_cast<ADCChannel>(i));
+        out.valid = adc_snapshot_.valid;
+    }
+
     void CTRL::log() const
     {
         ESP_LOGI("BQ2579X_CTRL", "ICO_Current_Limit = %dmA", ico_current_limit_ma.get_value());
 
         ESP_LOGI("BQ2579X_CTRL", "ADC Readings:");
-        ESP_LOGI("BQ2579X_CTRL", " IBUS  = %dmA", ibus_adc_ma.get_value());
-        ESP_LOGI("BQ2579X_CTRL", " IBAT  = %dmA", ibat_adc_ma.get_value());
-        ESP_LOGI("BQ2579X_CTRL", " VBUS  = %dmV", vbus_adc_mv.get_value());
-        ESP_LOGI("BQ2579X_CTRL", " VAC1  = %dmV", vac1_adc_mv.get_value());
-        ESP_LOGI("BQ2579X_CTRL", " VAC2  = %dmV", vacd2_adc_mv.get_value());
-        ESP_LOGI("BQ2579X_CTRL", " VBAT  = %dmV", vbat_adc_mv.get_value());
-        ESP_LOGI("BQ2579X_CTRL", " VSYS  = %dmV", vsys_adc_mv.get_value());
-        ESP_LOGI("BQ2579X_CTRL", " TS    = %.3f %%", ts_adc_mp.get_value() / 1000.0f); // TS en millièmes de pourcent (par exemple 23200 -> 23.200%)
-        ESP_LOGI("BQ2579X_CTRL", " TDIE  = %.1f °C", tdie_adc_dc.get_value() / 10.0f); // TDIE en dixièmes de degré (ex: 423 = 42.3 °C)
-        ESP_LOGI("BQ2579X_CTRL", " D+    = %dmV", dplus_adc_mv.get_value());
-        ESP_LOGI("BQ2579X_CTRL", " D-    = %dmV", dminus_adc_mv.get_value());
+        log_channel(ADCChannel::IBUS, "IBUS", adc_ibus_ma(adc_snapshot_.get_raw(ADCChannel::IBUS)), "mA");
+        log_channel(ADCChannel::IBAT, "IBAT", adc_ibat_ma(adc_snapshot_.get_raw(ADCChannel::IBAT)), "mA");
+        log_channel(ADCChannel::VBUS, "VBUS", adc_mv(adc_snapshot_.get_raw(ADCChannel::VBUS)), "mV");
+        log_channel(ADCChannel::VAC1, "VAC1", adc_mv(adc_snapshot_.get_raw(ADCChannel::VAC1)), "mV");
+        log_channel(ADCChannel::VAC2, "VAC2", adc_mv(adc_snapshot_.get_raw(ADCChannel::VAC2)), "mV");
+        log_channel(ADCChannel::VBAT, "VBAT", adc_mv(adc_snapshot_.get_raw(ADCChannel::VBAT)), "mV");
+        log_channel(ADCChannel::VSYS, "VSYS", adc_mv(adc_snapshot_.get_raw(ADCChannel::VSYS)), "mV");
+        if (adc_valid(ADCChannel::TS))
+            ESP_LOGI("BQ2579X_CTRL", " TS    = %.3f %%", adc_ts_milli_pct(adc_snapshot_.get_raw(ADCChannel::TS)) / 1000.0f); // TS en millièmes de pourcent (par exemple 23200 -> 23.200%)
+        else
+            ESP_LOGI("BQ2579X_CTRL", " TS    = n/a");
+        if (adc_valid(ADCChannel::TDIE))
+            ESP_LOGI("BQ2579X_CTRL", " TDIE  = %.1f °C", adc_tdie_dc(adc_snapshot_.get_raw(ADCChannel::TDIE)) / 10.0f); // TDIE en dixièmes de degré (ex: 423 = 42.3 °C)
+        else
+            ESP_LOGI("BQ2579X_CTRL", " TDIE  = n/a");
+        log_channel(ADCChannel::DPLUS, "D+", adc_mv(adc_snapshot_.get_raw(ADCChannel::DPLUS)), "mV");
+        log_channel(ADCChannel::DMINUS, "D-", adc_mv(adc_snapshot_.get_raw(ADCChannel::DMINUS)), "mV");
+    }
+
+    void CTRL::log_channel(ADCChannel ch, const char *label, int value, const char *unit) const
+    {
+        if (adc_valid(ch))
+            ESP_LOGI("BQ2579X_CTRL", " %-5s = %d%s", label, value, unit);
+        else
+            ESP_LOGI("BQ2579X_CTRL", " %-5s = n/a", label);
+    }
+
+    void CTRL::write_json(JsonWriter &w) const
+    {
+        // Voie désactivée ou non lue : null plutôt qu'un zéro trompeur
+        auto field = [&](ADCChannel ch, const char *key, auto value)
+        {
+            w.raw(key);
+            if (adc_valid(ch))
+                w.value(value);
+            else
+                w.null();
+        };
+
+        w.raw("{\"ico_current_ma\": ")
+            .value(ico_current_limit_ma.get_value());
+        field(ADCChannel::IBUS, ",\"ibus_ma\": ", adc_ibus_ma(adc_snapshot_.get_raw(ADCChannel::IBUS)));
+        field(ADCChannel::IBAT, ",\"ibat_ma\": ", adc_ibat_ma(adc_snapshot_.get_raw(ADCChannel::IBAT)));
+        field(ADCChannel::VBUS, ",\"vbus_mv\": ", adc_mv(adc_snapshot_.get_raw(ADCChannel::VBUS)));
+        field(ADCChannel::VAC1, ",\"vac1_mv\": ", adc_mv(adc_snapshot_.get_raw(ADCChannel::VAC1)));
+        field(ADCChannel::VAC2, ",\"vac2_mv\": ", adc_mv(adc_snapshot_.get_raw(ADCChannel::VAC2)));
+        field(ADCChannel::VBAT, ",\"vbat_mv\": ", adc_mv(adc_snapshot_.get_raw(ADCChannel::VBAT)));
+        field(ADCChannel::VSYS, ",\"vsys_mv\": ", adc_mv(adc_snapshot_.get_raw(ADCChannel::VSYS)));
+        field(ADCChannel::TS, ",\"ts_celsius_pct\": ", adc_ts_milli_pct(adc_snapshot_.get_raw(ADCChannel::TS)) / 1000.0f);
+        field(ADCChannel::TDIE, ",\"tdie_celsius\": ", adc_tdie_dc(adc_snapshot_.get_raw(ADCChannel::TDIE)) / 10.0f);
+        field(ADCChannel::DPLUS, ",\"dplus_mv\": ", adc_mv(adc_snapshot_.get_raw(ADCChannel::DPLUS)));
+        field(ADCChannel::DMINUS, ",\"dminus_mv\": ", adc_mv(adc_snapshot_.get_raw(ADCChannel::DMINUS)));
+        w.raw("}");
     }
 
     std::string CTRL::to_json() const
     {
-        return std::string("{") +
-               "\"ico_current_ma\": " + std::to_string(ico_current_limit_ma.get_value()) + "," +
-               "\"ibus_ma\": " + std::to_string(ibus_adc_ma.get_value()) + "," +
-               "\"ibat_ma\": " + std::to_string(ibat_adc_ma.get_value()) + "," +
-               "\"vbus_mv\": " + std::to_string(vbus_adc_mv.get_value()) + "," +
-               "\"vac1_mv\": " + std::to_string(vac1_adc_mv.get_value()) + "," +
-               "\"vac2_mv\": " + std::to_string(vacd2_adc_mv.get_value()) + "," +
-               "\"vbat_mv\": " + std::to_string(vbat_adc_mv.get_value()) + "," +
-               "\"vsys_mv\": " + std::to_string(vsys_adc_mv.get_value()) + "," +
-               "\"ts_celsius_pct\": " + std::to_string(ts_adc_mp.get_value() / 1000.0f) + "," +
-               "\"tdie_celsius\": " + std::to_string(tdie_adc_dc.get_value() / 10.0f) + "," +
-               "\"dplus_mv\": " + std::to_string(dplus_adc_mv.get_value()) + "," +
-               "\"dminus_mv\": " + std::to_string(dminus_adc_mv.get_value()) +
-               "}";
+        return to_json_string(*this);
     }
 
 } // namespace bq2579x
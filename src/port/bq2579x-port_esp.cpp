@@ -0,0 +1,61 @@
+#include "bq2579x-port.hpp"
+
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_intr_alloc.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+
+namespace bq2579x
+{
+    namespace port
+    {
+        namespace
+        {
+            const char *TAG = "BQ2579X_PORT";
+        }
+
+        esp_err_t alert_attach(int gpio, AlertHandler handler, void *arg)
+        {
+            static bool isr_installed = false;
+            gpio_config_t io_conf = {};
+            io_conf.intr_type = GPIO_INTR_NEGEDGE;
+            io_conf.mode = GPIO_MODE_INPUT;
+            io_conf.pin_bit_mask = (1ULL << gpio);
+            io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
+            esp_err_t err = gpio_config(&io_conf);
+            if (err != ESP_OK)
+                return err;
+
+            if (!isr_installed)
+            {
+                err = gpio_install_isr_service(ESP_INTR_FLAG_LEVEL3);
+                if (err != ESP_OK && err != ESP_ERR_INVALID_STATE)
+                {
+                    ESP_LOGE(TAG, "Failed to install ISR service: %s", esp_err_to_name(err));
+                    return err;
+                }
+                isr_installed = true;
+            }
+
+            return gpio_isr_handler_add(static_cast<gpio_num_t>(gpio), handler, arg);
+        }
+
+        bool alert_line_low(int gpio)
+        {
+            return gpio_get_level(static_cast<gpio_num_t>(gpio)) == 0;
+        }
+
+        uint32_t IRAM_ATTR cycle_count()
+        {
+            return static_cast<uint32_t>(esp_cpu_get_cycle_count());
+        }
+
+        uint32_t cycles_per_us()
+        {
+            return esp_rom_get_cpu_ticks_per_us();
+        }
+    } // namespace port
+
+} // namespace bq2579x
@@ -0,0 +1,51 @@
+#include "bq2579x-port.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace bq2579x
+{
+    namespace port
+    {
+        namespace
+        {
+            // Une seule ligne INT : celle du gestionnaire
+            std::atomic<AlertHandler> alert_handler{nullptr};
+            std::atomic<void *> alert_arg{nullptr};
+        }
+
+        esp_err_t alert_attach(int gpio, AlertHandler handler, void *arg)
+        {
+            alert_arg.store(arg);
+            alert_handler.store(handler);
+            return ESP_OK;
+        }
+
+        bool alert_line_low(int gpio)
+        {
+            // INT du simulateur : impulsion seule, la ligne revient aussitôt au repos
+            return false;
+        }
+
+        uint32_t cycle_count()
+        {
+            // Un « cycle » par nanoseconde d'horloge monotone
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch());
+            return static_cast<uint32_t>(ns.count());
+        }
+
+        uint32_t cycles_per_us()
+        {
+            return 1000;
+        }
+
+        void simulate_alert(void *ctx)
+        {
+            AlertHandler handler = alert_handler.load();
+            if (handler != nullptr)
+                handler(alert_arg.load());
+        }
+    } // namespace port
+
+} // namespace bq2579x
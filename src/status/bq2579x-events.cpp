@@ -0,0 +1,209 @@
+#include "status/bq2579x-events.hpp"
+
+namespace bq2579x
+{
+    namespace
+    {
+        // Bit 7 à bit 0 de chaque registre de flags ; COUNT : bit réservé
+        constexpr ChargerEvent X = ChargerEvent::COUNT;
+        constexpr ChargerEvent FLAG_EVENTS[STATUS::FLAGS_BLOCK_LEN][8] = {
+            {ChargerEvent::IINDPM, ChargerEvent::VINDPM, ChargerEvent::WATCHDOG, ChargerEvent::POOR_SOURCE,
+             ChargerEvent::POWER_GOOD, ChargerEvent::AC2_PRESENT, ChargerEvent::AC1_PRESENT, ChargerEvent::VBUS_PRESENT},
+            {ChargerEvent::CHG_STATE, ChargerEvent::ICO, X, ChargerEvent::VBUS_STATE,
+             X, ChargerEvent::TREG, ChargerEvent::VBAT_PRESENT, ChargerEvent::BC12_DONE},
+            {X, ChargerEvent::DPDM_DONE, ChargerEvent::ADC_DONE, ChargerEvent::VSYS_REG,
+             ChargerEvent::CHG_TIMER, ChargerEvent::TRICKLE_TIMER, ChargerEvent::PRECHG_TIMER, ChargerEvent::TOPOFF_TIMER},
+            {X, X, X, ChargerEvent::VBATOTG_LOW,
+             ChargerEvent::TS_COLD, ChargerEvent::TS_COOL, ChargerEvent::TS_WARM, ChargerEvent::TS_HOT},
+            {ChargerEvent::IBAT_REG, ChargerEvent::VBUS_OVP, ChargerEvent::VBAT_OVP, ChargerEvent::IBUS_OCP,
+             ChargerEvent::IBAT_OCP, ChargerEvent::CONV_OCP, ChargerEvent::VAC2_OVP, ChargerEvent::VAC1_OVP},
+            {ChargerEvent::VSYS_SHORT, ChargerEvent::VSYS_OVP, ChargerEvent::OTG_OVP, ChargerEvent::OTG_UVP,
+             X, ChargerEvent::TSHUT, X, X},
+        };
+
+        const char *const EVENT_NAMES[] = {
+            "IINDPM", "VINDPM", "WATCHDOG", "POOR_SOURCE", "POWER_GOOD", "AC2_PRESENT", "AC1_PRESENT", "VBUS_PRESENT",
+            "CHG_STATE", "ICO", "VBUS_STATE", "TREG", "VBAT_PRESENT", "BC12_DONE",
+            "DPDM_DONE", "ADC_DONE", "VSYS_REG", "CHG_TIMER", "TRICKLE_TIMER", "PRECHG_TIMER", "TOPOFF_TIMER",
+            "VBATOTG_LOW", "TS_COLD", "TS_COOL", "TS_WARM", "TS_HOT",
+            "IBAT_REG", "VBUS_OVP", "VBAT_OVP", "IBUS_OCP", "IBAT_OCP", "CONV_OCP", "VAC2_OVP", "VAC1_OVP",
+            "VSYS_SHORT", "VSYS_OVP", "OTG_OVP", "OTG_UVP", "TSHUT"};
+        static_assert(sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]) == static_cast<size_t>(ChargerEvent::COUNT),
+                      "event names out of sync");
+
+        template <typename Reg>
+        typename Reg::Values decode_status(const uint8_t *status)
+        {
+            Reg reg;
+            reg.set_raw(status[Reg::reg_addr - STATUS::STATUS_BLOCK_START]);
+            return reg.get_values();
+        }
+    }
+
+    const char *to_string(ChargerEvent e)
+    {
+        return e < ChargerEvent::COUNT ? EVENT_NAMES[static_cast<size_t>(e)] : "UNKNOWN";
+    }
+
+    ChargerStatus0Register::Values ChargerEventMessage::charger_status0() const
+    {
+        return decode_status<ChargerStatus0Register>(status);
+    }
+
+    ChargerStatus1Register::Values ChargerEventMessage::charger_status1() const
+    {
+        return decode_status<ChargerStatus1Register>(status);
+    }
+
+    FaultStatus0Register::Values ChargerEventMessage::fault_status0() const
+    {
+        return decode_status<FaultStatus0Register>(status);
+    }
+
+    FaultStatus1Register::Values ChargerEventMessage::fault_status1() const
+    {
+        return decode_status<FaultStatus1Register>(status);
+    }
+
+    uint64_t decode_events(const STATUS &status)
+    {
+        const uint8_t flags[STATUS::FLAGS_BLOCK_LEN] = {
+            status.charger_flag0.get_raw(), status.charger_flag1.get_raw(), status.charger_flag2.get_raw(),
+            status.charger_flag3.get_raw(), status.fault_flag0.get_raw(), status.fault_flag1.get_raw()};
+
+        uint64_t events = 0;
+        for (size_t r = 0; r < STATUS::FLAGS_BLOCK_LEN; ++r)
+        {
+            for (uint8_t bit = 0; bit < 8; ++bit)
+            {
+                const ChargerEvent e = FLAG_EVENTS[r][7 - bit];
+                if ((flags[r] & (1u << bit)) && e != X)
+                    events |= event_bit(e);
+            }
+        }
+        return events;
+    }
+
+    size_t unmasked_flags_span(const uint8_t (&masks)[STATUS::FLAGS_BLOCK_LEN])
+    {
+        size_t span = 0;
+        for (size_t r = 0; r < STATUS::FLAGS_BLOCK_LEN; ++r)
+        {
+            for (uint8_t bit = 0; bit < 8; ++bit)
+            {
+                if (FLAG_EVENTS[r][7 - bit] != X && !(masks[r] & (1u << bit)))
+                {
+                    span = r + 1;
+                    break;
+                }
+            }
+        }
+        return span;
+    }
+
+    bool event_flag_bit(ChargerEvent e, size_t &reg, uint8_t &bit)
+    {
+        for (size_t r = 0; r < STATUS::FLAGS_BLOCK_LEN; ++r)
+        {
+            for (uint8_t i = 0; i < 8; ++i)
+            {
+                if (FLAG_EVENTS[r][i] == e && e != X)
+                {
+                    reg = r;
+                    bit = static_cast<uint8_t>(7 - i);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    esp_err_t EVENT_DISPATCHER::add(const Subscriber &sub, int *id)
+    {
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < MAX_SUBSCRIBERS; ++i)
+        {
+            if (subscribers_[i].mask == 0)
+            {
+                subscribers_[i] = sub;
+                portEXIT_CRITICAL(&lock_);
+                if (id != nullptr)
+                    *id = static_cast<int>(i);
+                return ESP_OK;
+            }
+        }
+        portEXIT_CRITICAL(&lock_);
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t EVENT_DISPATCHER::subscribe(uint64_t mask, ChargerEventCallback callback, void *ctx, int *id)
+    {
+        if (callback == nullptr || (mask & EVENTS_ALL) == 0)
+            return ESP_ERR_INVALID_ARG;
+        Subscriber sub;
+        sub.mask = mask & EVENTS_ALL;
+        sub.callback = callback;
+        sub.ctx = ctx;
+        return add(sub, id);
+    }
+
+    esp_err_t EVENT_DISPATCHER::subscribe(uint64_t mask, QueueHandle_t queue, int *id)
+    {
+        if (queue == nullptr || (mask & EVENTS_ALL) == 0)
+            return ESP_ERR_INVALID_ARG;
+        Subscriber sub;
+        sub.mask = mask & EVENTS_ALL;
+        sub.queue = queue;
+        return add(sub, id);
+    }
+
+    esp_err_t EVENT_DISPATCHER::unsubscribe(int id)
+    {
+        if (id < 0 || static_cast<size_t>(id) >= MAX_SUBSCRIBERS)
+            return ESP_ERR_INVALID_ARG;
+        portENTER_CRITICAL(&lock_);
+        subscribers_[id] = {};
+        portEXIT_CRITICAL(&lock_);
+        return ESP_OK;
+    }
+
+    void EVENT_DISPATCHER::dispatch(const ChargerEventMessage &msg)
+    {
+        if (msg.events == 0)
+            return;
+
+        // Copie de la table : rappels et envois hors section critique
+        Subscriber subs[MAX_SUBSCRIBERS];
+        portENTER_CRITICAL(&lock_);
+        for (size_t i = 0; i < MAX_SUBSCRIBERS; ++i)
+            subs[i] = subscribers_[i];
+        portEXIT_CRITICAL(&lock_);
+
+        uint32_t dropped = 0;
+        for (const Subscriber &sub : subs)
+        {
+            if ((sub.mask & msg.events) == 0)
+                continue;
+            if (sub.callback != nullptr)
+                sub.callback(msg, sub.ctx);
+            else if (xQueueSend(sub.queue, &msg, 0) != pdTRUE)
+                dropped++;
+        }
+
+        if (dropped != 0)
+        {
+            portENTER_CRITICAL(&lock_);
+            dropped_ += dropped;
+            portEXIT_CRITICAL(&lock_);
+        }
+    }
+
+    uint32_t EVENT_DISPATCHER::dropped() const
+    {
+        portENTER_CRITICAL(&lock_);
+        uint32_t n = dropped_;
+        portEXIT_CRITICAL(&lock_);
+        return n;
+    }
+
+} // namespace bq2579x
@@ -121,29 +121,77 @@ namespace bq2579x
         return ESP_OK;
     }
 
+    void STATUS::decode_status_block(const uint8_t *block)
+    {
+        charger_status0.set_raw(block[charger_status0.reg_addr - STATUS_BLOCK_START]);
+        charger_status1.set_raw(block[charger_status1.reg_addr - STATUS_BLOCK_START]);
+        charger_status2.set_raw(block[charger_status2.reg_addr - STATUS_BLOCK_START]);
+        charger_status3.set_raw(block[charger_status3.reg_addr - STATUS_BLOCK_START]);
+        charger_status4.set_raw(block[charger_status4.reg_addr - STATUS_BLOCK_START]);
+        fault_status0.set_raw(block[fault_status0.reg_addr - STATUS_BLOCK_START]);
+        fault_status1.set_raw(block[fault_status1.reg_addr - STATUS_BLOCK_START]);
+    }
+
+    void STATUS::decode_flags_block(const uint8_t *block)
+    {
+        charger_flag0.set_raw(block[charger_flag0.reg_addr - FLAGS_BLOCK_START]);
+        charger_flag1.set_raw(block[charger_flag1.reg_addr - FLAGS_BLOCK_START]);
+        charger_flag2.set_raw(block[charger_flag2.reg_addr - FLAGS_BLOCK_START]);
+        charger_flag3.set_raw(block[charger_flag3.reg_addr - FLAGS_BLOCK_START]);
+        fault_flag0.set_raw(block[fault_flag0.reg_addr - FLAGS_BLOCK_START]);
+        fault_flag1.set_raw(block[fault_flag1.reg_addr - FLAGS_BLOCK_START]);
+    }
+
+    void STATUS::decode_snapshot(const uint8_t *block)
+    {
+        decode_status_block(block);
+        decode_flags_block(block + STATUS_BLOCK_LEN);
+    }
+
     esp_err_t STATUS::get_flags()
     {
-        RETURN_IF_ERROR(get_charger_flag0());
-        RETURN_IF_ERROR(get_charger_flag1());
-        RETURN_IF_ERROR(get_charger_flag2());
-        RETURN_IF_ERROR(get_charger_flag3());
-        RETURN_IF_ERROR(get_fault_flag0());
-        RETURN_IF_ERROR(get_fault_flag1());
+        uint8_t block[FLAGS_BLOCK_LEN];
+        RETURN_IF_ERROR(read_register(FLAGS_BLOCK_START, block, sizeof(block)));
+        decode_flags_block(block);
         return ESP_OK;
     }
 
     esp_err_t STATUS::get_status()
     {
-        RETURN_IF_ERROR(get_charger_status0());
-        RETURN_IF_ERROR(get_charger_status1());
-        RETURN_IF_ERROR(get_charger_status2());
-        RETURN_IF_ERROR(get_charger_status3());
-        RETURN_IF_ERROR(get_charger_status4());
-        RETURN_IF_ERROR(get_fault_status0());
-        RETURN_IF_ERROR(get_fault_status1());
+        uint8_t block[STATUS_BLOCK_LEN];
+        RETURN_IF_ERROR(read_register(STATUS_BLOCK_START, block, sizeof(block)));
+        decode_status_block(block);
+        return ESP_OK;
+    }
+
+    esp_err_t STATUS::get_snapshot()
+    {
+        return get_snapshot(FLAGS_BLOCK_LEN);
+    }
+
+    esp_err_t STATUS::get_snapshot(size_t flags_len)
+    {
+        if (flags_len > FLAGS_BLOCK_LEN)
+            return ESP_ERR_INVALID_ARG;
+
+        // Flags non lus : non effacés dans le composant, vus comme inactifs ici
+        uint8_t block[SNAPSHOT_LEN] = {};
+        RETURN_IF_ERROR(read_register(SNAPSHOT_START, block, STATUS_BLOCK_LEN + flags_len));
+        decode_snapshot(block);
         return ESP_OK;
     }
 
+    esp_err_t STATUS::discard_flags(size_t first, size_t end)
+    {
+        if (first > end || end > FLAGS_BLOCK_LEN)
+            return ESP_ERR_INVALID_ARG;
+        if (first == end)
+            return ESP_OK;
+
+        uint8_t block[FLAGS_BLOCK_LEN];
+        return read_register(static_cast<uint8_t>(FLAGS_BLOCK_START + first), block, end - first);
+    }
+
     void STATUS::log() const
     {
         charger_status0.log();
@@ -155,17 +203,28 @@ namespace bq2579x
         fault_status1.log();
     }
 
+    void STATUS::write_json(JsonWriter &w) const
+    {
+        w.raw("{\"charger_status0\": ");
+        charger_status0.write_json(w);
+        w.raw(",\"charger_status1\": ");
+        charger_status1.write_json(w);
+        w.raw(",\"charger_status2\": ");
+        charger_status2.write_json(w);
+        w.raw(",\"charger_status3\": ");
+        charger_status3.write_json(w);
+        w.raw(",\"charger_status4\": ");
+        charger_status4.write_json(w);
+        w.raw(",\"fault_status0\": ");
+        fault_status0.write_json(w);
+        w.raw(",\"fault_status1\": ");
+        fault_status1.write_json(w);
+        w.raw("}");
+    }
+
     std::string STATUS::to_json() const
     {
-        return std::string("{") +
-               "\"charger_status0\": " + charger_status0.to_json() + "," +
-               "\"charger_status1\": " + charger_status1.to_json() + "," +
-               "\"charger_status2\": " + charger_status2.to_json() + "," +
-               "\"charger_status3\": " + charger_status3.to_json() + "," +
-               "\"charger_status4\": " + charger_status4.to_json() + "," +
-               "\"fault_status0\": " + fault_status0.to_json() + "," +
-               "\"fault_status1\": " + fault_status1.to_json() +
-               "}";
+        return to_json_string(*this);
     }
 
 } // namespace bq2579x
@@ -49,19 +49,31 @@ namespace bq2579x
         }
     }
 
-    std::string ChargerStatus0Register::to_json() const
+    void ChargerStatus0Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"iindpm\": " + (v.iindpm_stat ? "true" : "false") + "," +
-               "\"vindpm\": " + (v.vindpm_stat ? "true" : "false") + "," +
-               "\"wd\": " + (v.wd_stat ? "true" : "false") + "," +
-               "\"pg\": " + (v.pg_stat ? "true" : "false") + "," +
-               "\"ac2\": " + (v.ac2_present ? "true" : "false") + "," +
-               "\"ac1\": " + (v.ac1_present ? "true" : "false") + "," +
-               "\"vbus\": " + (v.vbus_present ? "true" : "false") +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"iindpm\": ")
+            .raw(v.iindpm_stat ? "true" : "false")
+            .raw(",\"vindpm\": ")
+            .raw(v.vindpm_stat ? "true" : "false")
+            .raw(",\"wd\": ")
+            .raw(v.wd_stat ? "true" : "false")
+            .raw(",\"pg\": ")
+            .raw(v.pg_stat ? "true" : "false")
+            .raw(",\"ac2\": ")
+            .raw(v.ac2_present ? "true" : "false")
+            .raw(",\"ac1\": ")
+            .raw(v.ac1_present ? "true" : "false")
+            .raw(",\"vbus\": ")
+            .raw(v.vbus_present ? "true" : "false")
+            .raw("}");
+    }
+
+    std::string ChargerStatus0Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     ChargerStatus1Register::Values ChargerStatus1Register::get_values() const
@@ -153,15 +165,23 @@ namespace bq2579x
         }
     }
 
-    std::string ChargerStatus1Register::to_json() const
+    void ChargerStatus1Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"charge_status\": \"" + to_string(v.charge_status) + "\"," +
-               "\"vbus_status\": \"" + to_string(v.vbus_status) + "\"," +
-               "\"bc12_done\": " + (v.bc12_done ? "true" : "false") +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"charge_status\": \"")
+            .raw(to_string(v.charge_status))
+            .raw("\",\"vbus_status\": \"")
+            .raw(to_string(v.vbus_status))
+            .raw("\",\"bc12_done\": ")
+            .raw(v.bc12_done ? "true" : "false")
+            .raw("}");
+    }
+
+    std::string ChargerStatus1Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     ChargerStatus2Register::Values ChargerStatus2Register::get_values() const
@@ -211,16 +231,25 @@ namespace bq2579x
         }
     }
 
-    std::string ChargerStatus2Register::to_json() const
+    void ChargerStatus2Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"ico_status\": \"" + to_string(v.ico_status) + "\"," +
-               "\"treg\": " + (v.treg_stat ? "true" : "false") + "," +
-               "\"dpdm\": " + (v.dpdm_stat ? "true" : "false") + "," +
-               "\"vbat\": " + (v.vbat_present ? "true" : "false") +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"ico_status\": \"")
+            .raw(to_string(v.ico_status))
+            .raw("\",\"treg\": ")
+            .raw(v.treg_stat ? "true" : "false")
+            .raw(",\"dpdm\": ")
+            .raw(v.dpdm_stat ? "true" : "false")
+            .raw(",\"vbat\": ")
+            .raw(v.vbat_present ? "true" : "false")
+            .raw("}");
+    }
+
+    std::string ChargerStatus2Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     ChargerStatus3Register::Values ChargerStatus3Register::get_values() const
@@ -263,19 +292,31 @@ namespace bq2579x
         }
     }
 
-    std::string ChargerStatus3Register::to_json() const
+    void ChargerStatus3Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"acrb2\": " + (v.acrb2_stat ? "true" : "false") + "," +
-               "\"acrb1\": " + (v.acrb1_stat ? "true" : "false") + "," +
-               "\"adc_done\": " + (v.adc_done_stat ? "true" : "false") + "," +
-               "\"vsys\": " + (v.vsys_stat ? "true" : "false") + "," +
-               "\"chg_tmr\": " + (v.chg_tmr_stat ? "true" : "false") + "," +
-               "\"trichg_tmr\": " + (v.trichg_tmr_stat ? "true" : "false") + "," +
-               "\"prechg_tmr\": " + (v.prechg_tmr_stat ? "true" : "false") +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"acrb2\": ")
+            .raw(v.acrb2_stat ? "true" : "false")
+            .raw(",\"acrb1\": ")
+            .raw(v.acrb1_stat ? "true" : "false")
+            .raw(",\"adc_done\": ")
+            .raw(v.adc_done_stat ? "true" : "false")
+            .raw(",\"vsys\": ")
+            .raw(v.vsys_stat ? "true" : "false")
+            .raw(",\"chg_tmr\": ")
+            .raw(v.chg_tmr_stat ? "true" : "false")
+            .raw(",\"trichg_tmr\": ")
+            .raw(v.trichg_tmr_stat ? "true" : "false")
+            .raw(",\"prechg_tmr\": ")
+            .raw(v.prechg_tmr_stat ? "true" : "false")
+            .raw("}");
+    }
+
+    std::string ChargerStatus3Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     ChargerStatus4Register::Values ChargerStatus4Register::get_values() const
@@ -312,17 +353,27 @@ namespace bq2579x
         }
     }
 
-    std::string ChargerStatus4Register::to_json() const
+    void ChargerStatus4Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"vbatotg_low\": " + (v.vbatotg_low_stat ? "true" : "false") + "," +
-               "\"ts_cold\": " + (v.ts_cold_stat ? "true" : "false") + "," +
-               "\"ts_cool\": " + (v.ts_cool_stat ? "true" : "false") + "," +
-               "\"ts_warm\": " + (v.ts_warm_stat ? "true" : "false") + "," +
-               "\"ts_hot\": " + (v.ts_hot_stat ? "true" : "false") +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"vbatotg_low\": ")
+            .raw(v.vbatotg_low_stat ? "true" : "false")
+            .raw(",\"ts_cold\": ")
+            .raw(v.ts_cold_stat ? "true" : "false")
+            .raw(",\"ts_cool\": ")
+            .raw(v.ts_cool_stat ? "true" : "false")
+            .raw(",\"ts_warm\": ")
+            .raw(v.ts_warm_stat ? "true" : "false")
+            .raw(",\"ts_hot\": ")
+            .raw(v.ts_hot_stat ? "true" : "false")
+            .raw("}");
+    }
+
+    std::string ChargerStatus4Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     FaultStatus0Register::Values FaultStatus0Register::get_values() const
@@ -368,20 +419,33 @@ namespace bq2579x
         }
     }
 
-    std::string FaultStatus0Register::to_json() const
+    void FaultStatus0Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"ibat_reg\": " + (v.ibat_reg_stat ? "true" : "false") + "," +
-               "\"vbus_ovp\": " + (v.vbus_ovp_stat ? "true" : "false") + "," +
-               "\"vbat_ovp\": " + (v.vbat_ovp_stat ? "true" : "false") + "," +
-               "\"ibus_ocp\": " + (v.ibus_ocp_stat ? "true" : "false") + "," +
-               "\"ibat_ocp\": " + (v.ibat_ocp_stat ? "true" : "false") + "," +
-               "\"conv_ocp\": " + (v.conv_ocp_stat ? "true" : "false") + "," +
-               "\"vac2_ovp\": " + (v.vac2_ovp_stat ? "true" : "false") + "," +
-               "\"vac1_ovp\": " + (v.vac1_ovp_stat ? "true" : "false") +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"ibat_reg\": ")
+            .raw(v.ibat_reg_stat ? "true" : "false")
+            .raw(",\"vbus_ovp\": ")
+            .raw(v.vbus_ovp_stat ? "true" : "false")
+            .raw(",\"vbat_ovp\": ")
+            .raw(v.vbat_ovp_stat ? "true" : "false")
+            .raw(",\"ibus_ocp\": ")
+            .raw(v.ibus_ocp_stat ? "true" : "false")
+            .raw(",\"ibat_ocp\": ")
+            .raw(v.ibat_ocp_stat ? "true" : "false")
+            .raw(",\"conv_ocp\": ")
+            .raw(v.conv_ocp_stat ? "true" : "false")
+            .raw(",\"vac2_ovp\": ")
+            .raw(v.vac2_ovp_stat ? "true" : "false")
+            .raw(",\"vac1_ovp\": ")
+            .raw(v.vac1_ovp_stat ? "true" : "false")
+            .raw("}");
+    }
+
+    std::string FaultStatus0Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
     FaultStatus1Register::Values FaultStatus1Register::get_values() const
@@ -418,17 +482,27 @@ namespace bq2579x
         }
     }
 
-    std::string FaultStatus1Register::to_json() const
+    void FaultStatus1Register::write_json(JsonWriter &w) const
     {
         Values v = get_values();
-        return std::string("{") +
-               "\"value\": " + std::to_string(raw_) + "," +
-               "\"vsys_short\": " + (v.vsys_short_stat ? "true" : "false") + "," +
-               "\"vsys_ovp\": " + (v.vsys_ovp_stat ? "true" : "false") + "," +
-               "\"otg_ovp\": " + (v.otg_ovp_stat ? "true" : "false") + "," +
-               "\"otg_uvp\": " + (v.otg_uvp_stat ? "true" : "false") + "," +
-               "\"tshut\": " + (v.tshut_stat ? "true" : "false") +
-               "}";
+        w.raw("{\"value\": ")
+            .value(raw_)
+            .raw(",\"vsys_short\": ")
+            .raw(v.vsys_short_stat ? "true" : "false")
+            .raw(",\"vsys_ovp\": ")
+            .raw(v.vsys_ovp_stat ? "true" : "false")
+            .raw(",\"otg_ovp\": ")
+            .raw(v.otg_ovp_stat ? "true" : "false")
+            .raw(",\"otg_uvp\": ")
+            .raw(v.otg_uvp_stat ? "true" : "false")
+            .raw(",\"tshut\": ")
+            .raw(v.tshut_stat ? "true" : "false")
+            .raw("}");
+    }
+
+    std::string FaultStatus1Register::to_json() const
+    {
+        return to_json_string(*this);
     }
 
 }
\ No newline at end of file